@@ -62,6 +62,12 @@ namespace LibAIR2 {
     }
   }
 
+  bool ALMAAbsRet::g_Terminated(size_t &npost) const
+  {
+    npost=i->post.size();
+    return npost < iALMAAbsRet::n_samples;
+  }
+
   std::ostream & operator<<(std::ostream &os, 
 			    const  ALMAAbsInput &i)
   {
@@ -259,6 +265,9 @@ namespace LibAIR2 {
     ALMAAbsRet ar(TObs, 
 		  M_PI/2.0,  
 		  wvrchar);
+    size_t npost;
+    if(ar.g_Terminated(npost))
+      std::cout<<"Terminated after "<<npost<<std::endl;
     ALMAResBase res;
     ar.g_Res(res);
 
@@ -336,9 +345,24 @@ namespace LibAIR2 {
 
     size_t count=0;
 
-    BOOST_FOREACH(const ALMAAbsInput &x, il)
+    // The retrievals for the different antennas and time intervals
+    // are independent of each other (each has its own model and
+    // sampler) so they are done in parallel. Diagnostics and the
+    // bookkeeping of the results are done afterwards, in input
+    // order, so that the output does not depend on the number of
+    // threads.
+    const std::vector<ALMAAbsInput> inputs(il.begin(), il.end());
+    const int ninputs=inputs.size();
+    std::vector<ALMAResBase *> results(ninputs, (ALMAResBase *)NULL);
+    std::vector<int> problematic(ninputs, 0);
+    std::vector<std::string> tobsErrors(ninputs);
+    std::vector<size_t> terminatedAfter(ninputs);
+    std::vector<int> terminated(ninputs, 0);
+
+#pragma omp parallel for schedule(dynamic)
+    for(int k=0; k<ninputs; ++k)
     {
-      bool problematic = false;
+      const ALMAAbsInput &x=inputs[k];
       std::vector<double>  TObs(4);
       for(size_t i=0; i<4; ++i)
         TObs[i]=x.TObs[i];
@@ -346,34 +370,52 @@ namespace LibAIR2 {
 	checkTObs(TObs);
       }
       catch(const std::runtime_error rE){
-	std::cout << std::endl << "WARNING: problem with Tobs of antenna " << x.antno
-		  << std::endl << "         LibAIR2::checkTObs: " << rE.what() << std::endl;
-	std::cerr << std::endl << "WARNING: problem with Tobs of antenna " << x.antno
-		  << std::endl << "         LibAIR2::checkTObs: " << rE.what() << std::endl;
-	problematic = true;
+	problematic[k]=1;
+	tobsErrors[k]=rE.what();
       }
       ALMAWVRCharacter wvrchar;
       ALMAAbsRet ar(TObs, 
 		    x.el,  
 		    wvrchar);
+      terminated[k]=ar.g_Terminated(terminatedAfter[k]);
       ALMAResBase *ares=new ALMAResBase;      
-      if(!ar.g_Res(*ares)){
+      if(ar.g_Res(*ares)){
+	results[k]=ares;
+      }
+      else{
+	delete ares;
+      }
+    }
+
+    for(int k=0; k<ninputs; ++k)
+    {
+      const ALMAAbsInput &x=inputs[k];
+      if(terminated[k]){
+	std::cout<<"Terminated after "<<terminatedAfter[k]<<std::endl;
+      }
+      if(problematic[k]){
+	std::cout << std::endl << "WARNING: problem with Tobs of antenna " << x.antno
+		  << std::endl << "         LibAIR2::checkTObs: " << tobsErrors[k] << std::endl;
+	std::cerr << std::endl << "WARNING: problem with Tobs of antenna " << x.antno
+		  << std::endl << "         LibAIR2::checkTObs: " << tobsErrors[k] << std::endl;
+      }
+      if(results[k]==NULL){
 	std::cout << "WARNING: Bayesian evidence was zero for antenna " << x.antno << std::endl
-		  << "         TObs was " << TObs[0] << " " << TObs[1] << " " << TObs[2] << " " <<TObs[3] 
+		  << "         TObs was " << x.TObs[0] << " " << x.TObs[1] << " " << x.TObs[2] << " " << x.TObs[3] 
 		  << " K, elevation " << x.el/M_PI*180. << " deg" << std::endl;
 	std::cerr << "WARNING: Bayesian evidence was zero for antenna " << x.antno << std::endl
-		  << "         TObs was " << TObs[0] << " " << TObs[1] << " " << TObs[2] << " " <<TObs[3] 
+		  << "         TObs was " << x.TObs[0] << " " << x.TObs[1] << " " << x.TObs[2] << " " << x.TObs[3] 
 		  << " K, elevation " << x.el/M_PI*180. << " deg" << std::endl;
       }
       else{
-	res.push_back(ares);
+	res.push_back(results[k]);
 	newil.push_back(x);
 	if(fbFilled){
 	  newfb.push_back(fb[count++]);
 	}
       }
 	
-      if(problematic){
+      if(problematic[k]){
 	problemAnts.insert(x.antno);
       }
 
@@ -61,6 +61,11 @@ namespace LibAIR2 {
      */
     bool g_Res(ALMAResBase &res); 
 
+    /** \brief Return true if the sampling terminated before drawing
+	all the samples, with the number drawn in npost
+     */
+    bool g_Terminated(size_t &npost) const;
+
   };
 
   std::ostream & operator<<(std::ostream &os, 
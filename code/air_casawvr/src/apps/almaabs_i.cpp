@@ -19,6 +19,7 @@ namespace LibAIR2 {
 
   const double iALMAAbsRetLL::thermNoise=1.0;
   const size_t iALMAAbsRet::n_ss=200;
+  const size_t iALMAAbsRet::n_samples=10000;
 
   iALMAAbsRetLL::iALMAAbsRetLL(const std::vector<double> &TObs,
 			       double el,
@@ -68,13 +69,9 @@ namespace LibAIR2 {
     // So far not obvious it is necessary to enable this
     //ns->InitalS(new Minim::InitialRandom(n_ss));
 
-    evidence=ns->sample(10000);
+    evidence=ns->sample(n_samples);
     post=ns->g_post();
 
-    if (post.size() < 10000 )
-    {
-      std::cout<<"Terminated after "<<post.size()<<std::endl;
-    }
     if(evidence == 0.){
       return false;
     }
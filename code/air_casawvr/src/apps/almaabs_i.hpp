@@ -73,6 +73,10 @@ namespace LibAIR2 {
     /// Number of points in the live set
     static const size_t n_ss;
 
+    /// Number of samples drawn, fewer are in post if the sampling
+    /// terminated early
+    static const size_t n_samples;
+
     iALMAAbsRet(const std::vector<double> &TObs,
 		double el,
 		const ALMAWVRCharacter &WVRChar);
@@ -8,12 +8,15 @@
 
 */
 
+#include <map>
+
 #include "columns.hpp"
 
 #include "slice.hpp"
 #include "lineparams.hpp"
 #include "lineshapes.hpp"
 #include "basicphys.hpp"
+#include "partitionsum.hpp"
 
 namespace LibAIR2 {
 
@@ -78,7 +81,9 @@ namespace LibAIR2 {
 		 size_t nl):
     Column(0),
     ltable(get_h2o_lines()),
-    pt(pt)
+    pt(pt),
+    memoT(-1),
+    memoP(-1)
   {
     if (nl==0)
     {
@@ -94,26 +99,50 @@ namespace LibAIR2 {
 			  const Slice &s,
 			  std::vector<double> &res) const
   {
-    res=std::vector<double>(f.size(), 0.0);
-    const double N=getN();
-    CLineParams cp;
-
-    for(size_t i=0; i<nlines; ++i)
+    const double T=s.getT();
+    const double P=s.getP();
+    if (T != memoT || P != memoP || f != memoF)
     {
-      ComputeLineParsWQ(ltable[i], 
-			*pt,
-			s.getT(),
-			s.getP(),
-			0, 296,
-			cp);
+      memoTau=std::vector<double>(f.size(), 0.0);
+      CLineParams cp;
 
-      for(size_t i =0 ; i < f.size() ; ++i )
+      // The partition sum ratio only depends on the isotopologue, so
+      // evaluate it once per isotopologue rather than once per line
+      std::map<int, double> qratio;
+
+      for(size_t i=0; i<nlines; ++i)
       {
-	res[i]+=GrossLine(f[i],
-			  cp.f0,
-			  cp.gamma,
-			  cp.S)*N;
+	std::map<int, double>::iterator q=qratio.find(ltable[i].iso);
+	if (q == qratio.end())
+	{
+	  q=qratio.insert(std::make_pair(ltable[i].iso,
+					 pt->eval(296, ltable[i].iso)/pt->eval(T, ltable[i].iso))).first;
+	}
+	ComputeLinePars(ltable[i], 
+			T,
+			P,
+			0, 296,
+			cp);
+	cp.S *= q->second;
+
+	for(size_t j =0 ; j < f.size() ; ++j )
+	{
+	  memoTau[j]+=GrossLine(f[j],
+				cp.f0,
+				cp.gamma,
+				cp.S);
+	}
       }
+      memoT=T;
+      memoP=P;
+      memoF=f;
+    }
+
+    const double N=getN();
+    res.resize(f.size());
+    for(size_t j =0 ; j < f.size() ; ++j )
+    {
+      res[j]=memoTau[j]*N;
     }
   }
 
@@ -130,6 +130,16 @@ namespace LibAIR2 {
 
     const PartitionTable * pt;
 
+    /** The line sum is proportional to the column density, so the
+	opacity per unit column is memoised for the last temperature,
+	pressure and frequency grid. Models are re-evaluated many
+	times at the same (T, P) when only the water column changes
+	(e.g., the finite differences for dT/dL).
+     */
+    mutable double memoT, memoP;
+    mutable std::vector<double> memoF;
+    mutable std::vector<double> memoTau;
+
   public:
 
     H2OCol(const PartitionTable * pt,
@@ -308,8 +308,13 @@ using asdm::Parser;
 
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include <exception>
+#include <utility>
 #include <time.h>
 
+#include <libxml/parser.h>
+
 //#ifdef WITHOUT_ACS
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -4483,338 +4488,228 @@ namespace asdm {
 		if (!loadTablesOnDemand_) {
 			// Now read and parse all files for the tables whose number of rows appear as
 			// non null in the container just built.
-			Entity entity;
+			// The tables are independent from each other, so they are parsed concurrently
+			// in order that the large ones (Pointing, SysCal, CalAtmosphere...) do not hold the others.
+			// NB: this concurrent loading is a hand edit of the generated code; it must be
+			// carried over to the ASDM.cpp template of the generator, or it will be lost.
+			vector<pair<string, std::function<void ()> > > loaders;
 	
-			entity = tableEntity["Main"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getMain().setFromFile(directory_);
-			}
+			if (tableEntity["Main"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Main"), [this]() { getMain().setFromFile(directory_); }));
 	
-			entity = tableEntity["AlmaRadiometer"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getAlmaRadiometer().setFromFile(directory_);
-			}
+			if (tableEntity["AlmaRadiometer"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("AlmaRadiometer"), [this]() { getAlmaRadiometer().setFromFile(directory_); }));
 	
-			entity = tableEntity["Annotation"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getAnnotation().setFromFile(directory_);
-			}
+			if (tableEntity["Annotation"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Annotation"), [this]() { getAnnotation().setFromFile(directory_); }));
 	
-			entity = tableEntity["Antenna"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getAntenna().setFromFile(directory_);
-			}
+			if (tableEntity["Antenna"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Antenna"), [this]() { getAntenna().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalAmpli"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalAmpli().setFromFile(directory_);
-			}
+			if (tableEntity["CalAmpli"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalAmpli"), [this]() { getCalAmpli().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalAppPhase"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalAppPhase().setFromFile(directory_);
-			}
+			if (tableEntity["CalAppPhase"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalAppPhase"), [this]() { getCalAppPhase().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalAtmosphere"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalAtmosphere().setFromFile(directory_);
-			}
+			if (tableEntity["CalAtmosphere"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalAtmosphere"), [this]() { getCalAtmosphere().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalBandpass"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalBandpass().setFromFile(directory_);
-			}
+			if (tableEntity["CalBandpass"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalBandpass"), [this]() { getCalBandpass().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalCurve"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalCurve().setFromFile(directory_);
-			}
+			if (tableEntity["CalCurve"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalCurve"), [this]() { getCalCurve().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalData"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalData().setFromFile(directory_);
-			}
+			if (tableEntity["CalData"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalData"), [this]() { getCalData().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalDelay"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalDelay().setFromFile(directory_);
-			}
+			if (tableEntity["CalDelay"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalDelay"), [this]() { getCalDelay().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalDevice"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalDevice().setFromFile(directory_);
-			}
+			if (tableEntity["CalDevice"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalDevice"), [this]() { getCalDevice().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalFlux"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalFlux().setFromFile(directory_);
-			}
+			if (tableEntity["CalFlux"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalFlux"), [this]() { getCalFlux().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalFocus"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalFocus().setFromFile(directory_);
-			}
+			if (tableEntity["CalFocus"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalFocus"), [this]() { getCalFocus().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalFocusModel"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalFocusModel().setFromFile(directory_);
-			}
+			if (tableEntity["CalFocusModel"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalFocusModel"), [this]() { getCalFocusModel().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalGain"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalGain().setFromFile(directory_);
-			}
+			if (tableEntity["CalGain"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalGain"), [this]() { getCalGain().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalHolography"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalHolography().setFromFile(directory_);
-			}
+			if (tableEntity["CalHolography"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalHolography"), [this]() { getCalHolography().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalPhase"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalPhase().setFromFile(directory_);
-			}
+			if (tableEntity["CalPhase"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalPhase"), [this]() { getCalPhase().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalPointing"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalPointing().setFromFile(directory_);
-			}
+			if (tableEntity["CalPointing"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalPointing"), [this]() { getCalPointing().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalPointingModel"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalPointingModel().setFromFile(directory_);
-			}
+			if (tableEntity["CalPointingModel"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalPointingModel"), [this]() { getCalPointingModel().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalPosition"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalPosition().setFromFile(directory_);
-			}
+			if (tableEntity["CalPosition"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalPosition"), [this]() { getCalPosition().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalPrimaryBeam"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalPrimaryBeam().setFromFile(directory_);
-			}
+			if (tableEntity["CalPrimaryBeam"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalPrimaryBeam"), [this]() { getCalPrimaryBeam().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalReduction"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalReduction().setFromFile(directory_);
-			}
+			if (tableEntity["CalReduction"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalReduction"), [this]() { getCalReduction().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalSeeing"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalSeeing().setFromFile(directory_);
-			}
+			if (tableEntity["CalSeeing"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalSeeing"), [this]() { getCalSeeing().setFromFile(directory_); }));
 	
-			entity = tableEntity["CalWVR"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCalWVR().setFromFile(directory_);
-			}
+			if (tableEntity["CalWVR"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CalWVR"), [this]() { getCalWVR().setFromFile(directory_); }));
 	
-			entity = tableEntity["ConfigDescription"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getConfigDescription().setFromFile(directory_);
-			}
+			if (tableEntity["ConfigDescription"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("ConfigDescription"), [this]() { getConfigDescription().setFromFile(directory_); }));
 	
-			entity = tableEntity["CorrelatorMode"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getCorrelatorMode().setFromFile(directory_);
-			}
+			if (tableEntity["CorrelatorMode"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("CorrelatorMode"), [this]() { getCorrelatorMode().setFromFile(directory_); }));
 	
-			entity = tableEntity["DataDescription"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getDataDescription().setFromFile(directory_);
-			}
+			if (tableEntity["DataDescription"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("DataDescription"), [this]() { getDataDescription().setFromFile(directory_); }));
 	
-			entity = tableEntity["DelayModel"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getDelayModel().setFromFile(directory_);
-			}
+			if (tableEntity["DelayModel"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("DelayModel"), [this]() { getDelayModel().setFromFile(directory_); }));
 	
-			entity = tableEntity["DelayModelFixedParameters"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getDelayModelFixedParameters().setFromFile(directory_);
-			}
+			if (tableEntity["DelayModelFixedParameters"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("DelayModelFixedParameters"), [this]() { getDelayModelFixedParameters().setFromFile(directory_); }));
 	
-			entity = tableEntity["DelayModelVariableParameters"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getDelayModelVariableParameters().setFromFile(directory_);
-			}
+			if (tableEntity["DelayModelVariableParameters"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("DelayModelVariableParameters"), [this]() { getDelayModelVariableParameters().setFromFile(directory_); }));
 	
-			entity = tableEntity["Doppler"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getDoppler().setFromFile(directory_);
-			}
+			if (tableEntity["Doppler"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Doppler"), [this]() { getDoppler().setFromFile(directory_); }));
 	
-			entity = tableEntity["Ephemeris"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getEphemeris().setFromFile(directory_);
-			}
+			if (tableEntity["Ephemeris"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Ephemeris"), [this]() { getEphemeris().setFromFile(directory_); }));
 	
-			entity = tableEntity["ExecBlock"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getExecBlock().setFromFile(directory_);
-			}
+			if (tableEntity["ExecBlock"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("ExecBlock"), [this]() { getExecBlock().setFromFile(directory_); }));
 	
-			entity = tableEntity["Feed"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getFeed().setFromFile(directory_);
-			}
+			if (tableEntity["Feed"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Feed"), [this]() { getFeed().setFromFile(directory_); }));
 	
-			entity = tableEntity["Field"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getField().setFromFile(directory_);
-			}
+			if (tableEntity["Field"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Field"), [this]() { getField().setFromFile(directory_); }));
 	
-			entity = tableEntity["Flag"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getFlag().setFromFile(directory_);
-			}
+			if (tableEntity["Flag"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Flag"), [this]() { getFlag().setFromFile(directory_); }));
 	
-			entity = tableEntity["FlagCmd"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getFlagCmd().setFromFile(directory_);
-			}
+			if (tableEntity["FlagCmd"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("FlagCmd"), [this]() { getFlagCmd().setFromFile(directory_); }));
 	
-			entity = tableEntity["Focus"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getFocus().setFromFile(directory_);
-			}
+			if (tableEntity["Focus"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Focus"), [this]() { getFocus().setFromFile(directory_); }));
 	
-			entity = tableEntity["FocusModel"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getFocusModel().setFromFile(directory_);
-			}
+			if (tableEntity["FocusModel"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("FocusModel"), [this]() { getFocusModel().setFromFile(directory_); }));
 	
-			entity = tableEntity["FreqOffset"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getFreqOffset().setFromFile(directory_);
-			}
+			if (tableEntity["FreqOffset"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("FreqOffset"), [this]() { getFreqOffset().setFromFile(directory_); }));
 	
-			entity = tableEntity["GainTracking"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getGainTracking().setFromFile(directory_);
-			}
+			if (tableEntity["GainTracking"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("GainTracking"), [this]() { getGainTracking().setFromFile(directory_); }));
 	
-			entity = tableEntity["History"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getHistory().setFromFile(directory_);
-			}
+			if (tableEntity["History"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("History"), [this]() { getHistory().setFromFile(directory_); }));
 	
-			entity = tableEntity["Holography"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getHolography().setFromFile(directory_);
-			}
+			if (tableEntity["Holography"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Holography"), [this]() { getHolography().setFromFile(directory_); }));
 	
-			entity = tableEntity["Observation"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getObservation().setFromFile(directory_);
-			}
+			if (tableEntity["Observation"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Observation"), [this]() { getObservation().setFromFile(directory_); }));
 	
-			entity = tableEntity["Pointing"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getPointing().setFromFile(directory_);
-			}
+			if (tableEntity["Pointing"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Pointing"), [this]() { getPointing().setFromFile(directory_); }));
 	
-			entity = tableEntity["PointingModel"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getPointingModel().setFromFile(directory_);
-			}
+			if (tableEntity["PointingModel"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("PointingModel"), [this]() { getPointingModel().setFromFile(directory_); }));
 	
-			entity = tableEntity["Polarization"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getPolarization().setFromFile(directory_);
-			}
+			if (tableEntity["Polarization"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Polarization"), [this]() { getPolarization().setFromFile(directory_); }));
 	
-			entity = tableEntity["Processor"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getProcessor().setFromFile(directory_);
-			}
+			if (tableEntity["Processor"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Processor"), [this]() { getProcessor().setFromFile(directory_); }));
 	
-			entity = tableEntity["Receiver"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getReceiver().setFromFile(directory_);
-			}
+			if (tableEntity["Receiver"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Receiver"), [this]() { getReceiver().setFromFile(directory_); }));
 	
-			entity = tableEntity["SBSummary"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSBSummary().setFromFile(directory_);
-			}
+			if (tableEntity["SBSummary"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("SBSummary"), [this]() { getSBSummary().setFromFile(directory_); }));
 	
-			entity = tableEntity["Scale"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getScale().setFromFile(directory_);
-			}
+			if (tableEntity["Scale"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Scale"), [this]() { getScale().setFromFile(directory_); }));
 	
-			entity = tableEntity["Scan"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getScan().setFromFile(directory_);
-			}
+			if (tableEntity["Scan"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Scan"), [this]() { getScan().setFromFile(directory_); }));
 	
-			entity = tableEntity["Seeing"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSeeing().setFromFile(directory_);
-			}
+			if (tableEntity["Seeing"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Seeing"), [this]() { getSeeing().setFromFile(directory_); }));
 	
-			entity = tableEntity["Source"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSource().setFromFile(directory_);
-			}
+			if (tableEntity["Source"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Source"), [this]() { getSource().setFromFile(directory_); }));
 	
-			entity = tableEntity["SpectralWindow"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSpectralWindow().setFromFile(directory_);
-			}
+			if (tableEntity["SpectralWindow"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("SpectralWindow"), [this]() { getSpectralWindow().setFromFile(directory_); }));
 	
-			entity = tableEntity["SquareLawDetector"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSquareLawDetector().setFromFile(directory_);
-			}
+			if (tableEntity["SquareLawDetector"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("SquareLawDetector"), [this]() { getSquareLawDetector().setFromFile(directory_); }));
 	
-			entity = tableEntity["State"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getState().setFromFile(directory_);
-			}
+			if (tableEntity["State"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("State"), [this]() { getState().setFromFile(directory_); }));
 	
-			entity = tableEntity["Station"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getStation().setFromFile(directory_);
-			}
+			if (tableEntity["Station"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Station"), [this]() { getStation().setFromFile(directory_); }));
 	
-			entity = tableEntity["Subscan"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSubscan().setFromFile(directory_);
-			}
+			if (tableEntity["Subscan"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Subscan"), [this]() { getSubscan().setFromFile(directory_); }));
 	
-			entity = tableEntity["SwitchCycle"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSwitchCycle().setFromFile(directory_);
-			}
+			if (tableEntity["SwitchCycle"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("SwitchCycle"), [this]() { getSwitchCycle().setFromFile(directory_); }));
 	
-			entity = tableEntity["SysCal"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSysCal().setFromFile(directory_);
-			}
+			if (tableEntity["SysCal"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("SysCal"), [this]() { getSysCal().setFromFile(directory_); }));
 	
-			entity = tableEntity["SysPower"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getSysPower().setFromFile(directory_);
-			}
+			if (tableEntity["SysPower"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("SysPower"), [this]() { getSysPower().setFromFile(directory_); }));
 	
-			entity = tableEntity["TotalPower"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getTotalPower().setFromFile(directory_);
-			}
+			if (tableEntity["TotalPower"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("TotalPower"), [this]() { getTotalPower().setFromFile(directory_); }));
 	
-			entity = tableEntity["WVMCal"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getWVMCal().setFromFile(directory_);
-			}
+			if (tableEntity["WVMCal"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("WVMCal"), [this]() { getWVMCal().setFromFile(directory_); }));
 	
-			entity = tableEntity["Weather"];
-			if (entity.getEntityId().getId().length()  != 0) {
-				getWeather().setFromFile(directory_);
+			if (tableEntity["Weather"].getEntityId().getId().length()  != 0)
+				loaders.push_back(make_pair(string("Weather"), [this]() { getWeather().setFromFile(directory_); }));
+
+			// libxml2 must be initialized by the main thread.
+			xmlInitParser();
+
+			// An exception is rethrown once all the parsings are over, the first
+			// one in the order of the tables above.
+			vector<exception_ptr> errors(loaders.size());
+#pragma omp parallel for schedule(dynamic)
+			for (int i = 0; i < (int) loaders.size(); i++) {
+				if (getenv("ASDM_DEBUG")) cout << "About to parse the " << loaders[i].first << " table" << endl;
+				try {
+					loaders[i].second();
+				}
+				catch (...) {
+					errors[i] = current_exception();
+				}
 			}
-	
+			for (unsigned int i = 0; i < errors.size(); i++)
+				if (errors[i]) rethrow_exception(errors[i]);
 		}
 		else {
 	
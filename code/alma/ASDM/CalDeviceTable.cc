@@ -453,11 +453,13 @@ CalDeviceRow* CalDeviceTable::newRow(CalDeviceRow* row) {
 	CalDeviceRow* CalDeviceTable::getRowByKey(Tag antennaId, Tag spectralWindowId, ArrayTimeInterval timeInterval, int feedId)  {
 		checkPresenceInMemory();
  		string keystr = Key(antennaId, spectralWindowId, feedId);
- 		vector<CalDeviceRow *> row;
+ 		// NB: this in place lookup is a hand edit of the generated code; it must be
+ 		// carried over to the Table.cpp template of the generator, or it will be lost.
+ 		map<string, TIME_ROWS >::const_iterator iter = context.find(keystr);
+ 		if (iter == context.end()) return 0;
  		
- 		if ( context.find(keystr)  == context.end()) return 0;
- 		
- 		row = context[keystr];
+ 		// Work on the rows of the context in place rather than on a copy of them.
+ 		const TIME_ROWS& row = iter->second;
  		
  		// Is the vector empty...impossible in principle !
  		if (row.size() == 0) return 0;
@@ -521,7 +521,9 @@ namespace asdm {
     int docTxtLen = 0;
     
     if (getenv("ASDM_DEBUG")) cout << "About to read and parse " << xmlPath << endl;
-    doc = xmlParseFile(xmlPath.c_str());
+    // The parser options are passed explicitly rather than through libxml2's
+    // per thread defaults, since the tables of a dataset may be parsed concurrently.
+    doc = xmlReadFile(xmlPath.c_str(), NULL, XML_PARSE_NOENT | XML_PARSE_DTDLOAD);
     if (doc == NULL) {
       throw XSLTransformerException("Could not parse the XML file '" + xmlPath + "'." );
     }
@@ -482,9 +482,13 @@ TotalPowerRow* TotalPowerTable::newRow(TotalPowerRow* row) {
  		checkPresenceInMemory();
 		string keystr = Key(configDescriptionId, fieldId);
  		
- 		if (context.find(keystr) == context.end()) return 0;
+ 		// NB: this in place lookup is a hand edit of the generated code; it must be
+ 		// carried over to the Table.cpp template of the generator, or it will be lost.
+ 		map<string, TIME_ROWS >::const_iterator iter = context.find(keystr);
+ 		if (iter == context.end()) return 0;
  		
- 		vector<TotalPowerRow* > row = context[keystr];
+ 		// Work on the rows of the context in place rather than on a copy of them.
+ 		const TIME_ROWS& row = iter->second;
  		
  		// Is the vector empty...impossible in principle !
 		if (row.size() == 0) return 0;
@@ -63,6 +63,8 @@
 #include <casa/iomanip.h>
 
 #include <algorithm>
+#include <exception>
+#include <thread>
 #include <casa/OS/Directory.h>
 #include <alma/ASDM/ASDMAll.h>
 #include <alma/ASDMBinaries/SDMDataObjectWriter.h>
@@ -756,6 +758,71 @@ namespace casa {
       unsigned int integrationNum = 1;
       uInt mainTabRow=startRow; 
 
+      String dataColumn(datacolumn);
+      dataColumn.upcase();
+
+      // The binary data of one integration. Two sets are kept, and their storage
+      // is reused: while one integration is written to the BDF on the writer
+      // thread, the next one is read from the MS into the other set.
+      // Only this thread reads the MS, and only one thread at a time uses sdmdow.
+      struct Integration {
+	uint64_t timev;
+	uint64_t intervalv;
+	vector< unsigned int > flags;
+	vector< int64_t > actualTimes;
+	vector< int64_t > actualDurations;
+	vector< float > zeroLags; // LAG_DATA, optional column, not used for the moment
+	vector< float > crossData;
+	// vector< short > crossData;
+	// vector< int > crossData; // standard case for ALMA
+	vector< float > autoData;	 
+      } integrations[2];
+      for(uInt k=0; k<2; k++){
+	integrations[k].flags.reserve(bpFlagsSize);
+	integrations[k].crossData.reserve(bpCrossSize);
+	integrations[k].autoData.reserve(bpAutoSize);
+      }
+      uInt current = 0;
+
+      std::thread writer;
+      Bool written = false;
+      string writeError;
+      std::exception_ptr writeFailure;
+      // joins the writer thread if the loop below is left by an exception
+      struct WriterGuard {
+	std::thread& t;
+	~WriterGuard(){ if(t.joinable()){ t.join(); } }
+      } writerGuard = {writer};
+
+      // wait for the integration on the writer thread and account for it
+      auto finishWrite = [&](const Integration& intg){
+	if(!writer.joinable()){
+	  return;
+	}
+	writer.join();
+	if(writeFailure){
+	  std::rethrow_exception(writeFailure);
+	}
+	if(written){
+	  integrationNum++;
+	  datasize += intg.flags.size() * sizeof(unsigned int)
+	    + intg.actualTimes.size() * sizeof( int64_t )
+	    + intg.actualDurations.size() * sizeof( int64_t )
+	    + intg.zeroLags.size() * sizeof( float )
+	    + intg.crossData.size() * sizeof( float )
+	    + intg.autoData.size() * sizeof( float );
+	  numIntegrations++;
+	}
+	else{
+	  os << LogIO::WARN << "Error writing ASDM:" << writeError << endl
+	     << "Will try to continue ..."
+	     << LogIO::POST; 
+	}
+      };
+
+      // position of each baseline (antenna1*1000 + antenna2) in the rows of an integration
+      map<Int, uInt> bLineRow;
+
       while(mainTabRow <= endRow){
 	
 	DDId = dataDescId()(mainTabRow);
@@ -769,16 +836,22 @@ namespace casa {
 	  continue;
 	}
 	
-	uint64_t timev = (uint64_t) floor((time()(mainTabRow))*1E9); // what units? nanoseconds
-	uint64_t intervalv = (uint64_t) floor(interval()(mainTabRow)*1E9);
-	vector< unsigned int > flags;
-	vector< int64_t > actualTimes;
-	vector< int64_t > actualDurations;
-	vector< float > zeroLags; // LAG_DATA, optional column, not used for the moment
-	vector< float > crossData;
-	// vector< short > crossData;
-	// vector< int > crossData; // standard case for ALMA
-	vector< float > autoData;	 
+	Integration& intg = integrations[current];
+	vector< unsigned int >& flags = intg.flags;
+	vector< int64_t >& actualTimes = intg.actualTimes;
+	vector< int64_t >& actualDurations = intg.actualDurations;
+	vector< float >& zeroLags = intg.zeroLags;
+	vector< float >& crossData = intg.crossData;
+	vector< float >& autoData = intg.autoData;
+
+	intg.timev = (uint64_t) floor((time()(mainTabRow))*1E9); // what units? nanoseconds
+	intg.intervalv = (uint64_t) floor(interval()(mainTabRow)*1E9);
+	flags.clear();
+	actualTimes.clear();
+	actualDurations.clear();
+	zeroLags.clear();
+	crossData.clear();
+	autoData.clear();
 	
 	////////////////////////////////////////////////////////
 	// fill data, time, and flag vectors for this timestamp
@@ -809,11 +882,12 @@ namespace casa {
 	  }
 
 	  uInt nRows = rows.size();
-	  vector<Int> bLine(nRows);
 	  uInt maxAnt = 0;
+	  bLineRow.clear();
 	  for(uInt i=0; i<nRows; i++){
 	    uInt a2 = antenna2()(rows[i]);
-	    bLine[i] = antenna1()(rows[i])*1000 + a2;
+	    // only the first row of a baseline is used
+	    bLineRow.insert(std::make_pair(antenna1()(rows[i])*1000 + a2, rows[i]));
 	    if(maxAnt<a2){
 	      maxAnt=a2;
 	    }
@@ -832,20 +906,16 @@ namespace casa {
 	    throw(asdmbinaries::SDMDataObjectWriterException(oss.str()));
 	  }
 	  uInt count=0;
-	  for(uInt i= (haveAuto ? 0 : 1) ; i<maxAnt+1; i++){
+	  for(uInt i= (haveAuto ? 0 : 1) ; nRows>0 && i<maxAnt+1; i++){
 	    for(uInt j=0; j< (haveAuto ? i+1 : i); j++){
 	      Int myBLine = j*1000 + i;
-	      for(uInt ii=0; ii<nRows; ii++){
-		if(bLine[ii]==myBLine){
-		  rowsSorted[count] = rows[ii];
-		  break;
-		}
-		if(ii==nRows-1){ // not found
-		  ostringstream oss;
-		  oss << "Baseline " << myBLine << " not found." << endl;
-		  throw(asdmbinaries::SDMDataObjectWriterException(oss.str()));
-		}
+	      map<Int, uInt>::const_iterator bl = bLineRow.find(myBLine);
+	      if(bl == bLineRow.end()){ // not found
+		ostringstream oss;
+		oss << "Baseline " << myBLine << " not found." << endl;
+		throw(asdmbinaries::SDMDataObjectWriterException(oss.str()));
 	      }
+	      rowsSorted[count] = bl->second;
 	      count++;
 	    }
 	  }
@@ -861,8 +931,6 @@ namespace casa {
 	  
 	  Matrix<casacore::Complex> dat;
 	  Matrix<Bool> flagsm;
-	  String dataColumn(datacolumn);
-	  dataColumn.upcase();
 	  if(dataColumn == "MODEL"){
 	    dat.reference(modelData()(iRow));
 	  }
@@ -910,13 +978,14 @@ namespace casa {
 	  }
 
 	  unsigned int ul;
+	  Bool rowFlagged = flagRow()(iRow);
 	  for(uInt i=0; i<numSpectralPoint; i++){
 	    for(uInt j=0; j<numStokesMS; j++){
 	      if(haveAuto && skipCorr_p[PolId][j]){
 		continue;
 	      }
 	      else{
-		if(flagRow()(iRow)){
+		if(rowFlagged){
 		  ul = 1;
 		}
 		else{
@@ -995,37 +1064,37 @@ namespace casa {
 	  cout << "   autoData " << autoData.size() << endl;
 	}
 
-	try{
-
-	  sdmdow.addIntegration(integrationNum,    // integration's index.
-				timev,             // midpoint
-				intervalv,         // time interval
-				flags,             // flags binary data 
-				actualTimes,       // actual times binary data      
-				actualDurations,   // actual durations binary data          
-				zeroLags,          // zero lags binary data                 
-				crossData,    // cross data (can be short or int)  
-				autoData);         // single dish data.  
-
-	  integrationNum++;
-	  datasize += flags.size() * sizeof(unsigned int)
-	    + actualTimes.size() * sizeof( int64_t )
-	    + actualDurations.size() * sizeof( int64_t )
-	    + zeroLags.size() * sizeof( float )
-	    + crossData.size() * sizeof( float )
-	    + autoData.size() * sizeof( float );
-	  numIntegrations++;
-
-	}
-	catch(asdmbinaries::SDMDataObjectWriterException x){
-	  os << LogIO::WARN << "Error writing ASDM:" << x.getMessage() << endl
-	     << "Will try to continue ..."
-	     << LogIO::POST; 
-	}
+	// finally write the integration, on the writer thread once the previous one is written
+	finishWrite(integrations[1-current]);
+	written = false;
+	const Integration* toWrite = &intg;
+	writer = std::thread([&sdmdow, toWrite, &written, &writeError, &writeFailure, integrationNum](){
+	  try{
+	    sdmdow.addIntegration(integrationNum,    // integration's index.
+				  toWrite->timev,    // midpoint
+				  toWrite->intervalv, // time interval
+				  toWrite->flags,    // flags binary data 
+				  toWrite->actualTimes, // actual times binary data      
+				  toWrite->actualDurations, // actual durations binary data          
+				  toWrite->zeroLags, // zero lags binary data                 
+				  toWrite->crossData, // cross data (can be short or int)  
+				  toWrite->autoData); // single dish data.  
+	    written = true;
+	  }
+	  catch(asdmbinaries::SDMDataObjectWriterException& x){
+	    writeError = x.getMessage();
+	  }
+	  catch(...){
+	    writeFailure = std::current_exception();
+	  }
+	});
+	current = 1-current;
 	// (Note: subintegrations are used only for channel averaging to gain time res. by sacrificing spec. res.)
 	
       } // end while 
       
+      finishWrite(integrations[1-current]);
+
       sdmdow.done();
       
       ofs.close();
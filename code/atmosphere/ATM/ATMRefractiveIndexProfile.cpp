@@ -25,8 +25,11 @@
 
 #include "ATMRefractiveIndexProfile.h"
 
+#include <deque>
 #include <iostream>
+#include <map>
 #include <math.h>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -34,6 +37,54 @@ using namespace std;
 
 ATM_NAMESPACE_BEGIN
 
+namespace {
+
+/** Process-wide cache of the layer profiles of the refractive index, keyed on the P/T/gas profile
+ *  and then on the channel frequency. Objects built repeatedly for the same atmosphere (e.g. one
+ *  SkyStatus per scan with identical basic parameters) reuse the profiles computed by the first one.
+ *  Only the most recent atmospheric profiles are kept.
+ */
+class RefractiveIndexProfileCache
+{
+public:
+  typedef map<double, vector<vector<complex<double> > > > ChannelMap;
+
+  static RefractiveIndexProfileCache &instance()
+  {
+    static RefractiveIndexProfileCache cache;
+    return cache;
+  }
+
+  ChannelMap *find(const vector<double> &profileKey)
+  {
+    map<vector<double>, ChannelMap>::iterator it = profiles_.find(profileKey);
+    return it == profiles_.end() ? 0 : &it->second;
+  }
+
+  ChannelMap &insert(const vector<double> &profileKey)
+  {
+    map<vector<double>, ChannelMap>::iterator it = profiles_.find(profileKey);
+    if(it != profiles_.end()) return it->second;
+    if(order_.size() >= maxProfiles_) {
+      profiles_.erase(order_.front());
+      order_.pop_front();
+    }
+    order_.push_back(profileKey);
+    return profiles_[profileKey];
+  }
+
+  std::mutex mutex_;
+
+private:
+  RefractiveIndexProfileCache() : maxProfiles_(8) {}
+
+  const unsigned int maxProfiles_;
+  map<vector<double>, ChannelMap> profiles_;
+  deque<vector<double> > order_;
+};
+
+}
+
 // Constructors
 
 RefractiveIndexProfile::RefractiveIndexProfile(const Frequency &freq,
@@ -282,252 +333,196 @@ bool RefractiveIndexProfile::setBasicAtmosphericParameters(const Length &altitud
   return updated;
 }
 
-void RefractiveIndexProfile::mkRefractiveIndexProfile()
+void RefractiveIndexProfile::mkRefractiveIndexChannel(double nu,
+                                                      vector<complex<double> >* const v_NPtr[9]) const
 {
-
-  //    static const double abun_18o=0.0020439;
-  //    static const double abun_17o=0.0003750;
-  //    static const double abun_D=0.000298444;
-  //    static const double o2_mixing_ratio=0.2092;
-  //    static const double mmol_h2o=18.005059688;  //   20*0.0020439+19*(0.0003750+2*0.000298444)+18*(1-0.0020439-0.0003750-2*0.000298444)
-
-  // static bool first = true;   // [-Wunused_but_set_variable]
-
+  // layout of v_NPtr: O2 lines, H2O cont, dry cont, H2O lines, O3 lines, CO lines, N2O lines, NO2 lines, SO2 lines
+  RefractiveIndex atm;
   double abun_O3, abun_CO, abun_N2O, abun_NO2, abun_SO2;
   double wvt, wv;
-  // double t; // [-Wunused_but_set_variable]
-  double nu;
-  // double nu2, nu_pi; // [-Wunused_but_set_variable]
-  // double width;
-  // unsigned int npoints;
-  RefractiveIndex atm;
-  //    double sumAbsO3Lines1, sumAbsCOLines1, sumAbsN2OLines1, sumAbsNO2Lines1, sumAbsSO2Lines1; 
-
-
-  //TODO we will have to put numLayer_ and v_chanFreq_.size() const
-  //we do not want to resize! ==> pas de setter pour SpectralGrid
 
-  //cout << "vv_N_H2OLinesPtr_.size()=" << vv_N_H2OLinesPtr_.size() << endl;
-  if(vv_N_H2OLinesPtr_.size() == 0) { // first time
-    vv_N_H2OLinesPtr_.reserve(v_chanFreq_.size());
-    vv_N_H2OContPtr_.reserve(v_chanFreq_.size());
-    vv_N_O2LinesPtr_.reserve(v_chanFreq_.size());
-    vv_N_DryContPtr_.reserve(v_chanFreq_.size());
-    vv_N_O3LinesPtr_.reserve(v_chanFreq_.size());
-    vv_N_COLinesPtr_.reserve(v_chanFreq_.size());
-    vv_N_N2OLinesPtr_.reserve(v_chanFreq_.size());
-    vv_N_NO2LinesPtr_.reserve(v_chanFreq_.size());
-    vv_N_SO2LinesPtr_.reserve(v_chanFreq_.size());
-  } else {
-    if(vv_N_H2OLinesPtr_.size() == v_chanFreq_.size()) // there are new basic param
-    rmRefractiveIndexProfile(); // delete all the layer profiles for all the frequencies
-  }
-
-  vector<complex<double> >* v_N_H2OLinesPtr;
-  vector<complex<double> >* v_N_H2OContPtr;
-  vector<complex<double> >* v_N_O2LinesPtr;
-  vector<complex<double> >* v_N_DryContPtr;
-  vector<complex<double> >* v_N_O3LinesPtr;
-  vector<complex<double> >* v_N_COLinesPtr;
-  vector<complex<double> >* v_N_N2OLinesPtr;
-  vector<complex<double> >* v_N_NO2LinesPtr;
-  vector<complex<double> >* v_N_SO2LinesPtr;
-
-  // cout << "v_chanFreq_.size()=" << v_chanFreq_.size() << endl;
-  // cout << "numLayer_=" << numLayer_ << endl;
-  // cout << "v_chanFreq_[0]=" << v_chanFreq_[0] << endl;
-  // check if new spectral windows have been added
-  unsigned int ncmin;
-  /*  cout << "vv_N_H2OLinesPtr_.size()="<<vv_N_H2OLinesPtr_.size()<<endl; */
-  ncmin = vv_N_H2OLinesPtr_.size(); // will be > 0 if spectral window(s) have been added
-  if(newBasicParam_) ncmin = 0;
-
-  //    cout << "ncmin=" << ncmin << endl;
-
-  for(unsigned int nc = ncmin; nc < v_chanFreq_.size(); nc++) {
+  for(unsigned int n = 0; n < 9; n++) v_NPtr[n]->resize(numLayer_);
 
-    v_N_H2OLinesPtr = new vector<complex<double> > ;
-    v_N_H2OContPtr = new vector<complex<double> > ;
-    v_N_O2LinesPtr = new vector<complex<double> > ;
-    v_N_DryContPtr = new vector<complex<double> > ;
-    v_N_O3LinesPtr = new vector<complex<double> > ;
-    v_N_COLinesPtr = new vector<complex<double> > ;
-    v_N_N2OLinesPtr = new vector<complex<double> > ;
-    v_N_NO2LinesPtr = new vector<complex<double> > ;
-    v_N_SO2LinesPtr = new vector<complex<double> > ;
-    v_N_H2OLinesPtr->reserve(numLayer_);
-    v_N_H2OContPtr->reserve(numLayer_);
-    v_N_O2LinesPtr->reserve(numLayer_);
-    v_N_DryContPtr->reserve(numLayer_);
-    v_N_O3LinesPtr->reserve(numLayer_);
-    v_N_COLinesPtr->reserve(numLayer_);
-    v_N_N2OLinesPtr->reserve(numLayer_);
-    v_N_NO2LinesPtr->reserve(numLayer_);
-    v_N_SO2LinesPtr->reserve(numLayer_);
-
-    nu = 1.0E-9 * v_chanFreq_[nc]; // ATM uses GHz units
+  for(unsigned int j = 0; j < numLayer_; j++) {
 
-    // cout << "freq. points =" << v_chanFreq_.size() << endl;
+    wv = v_layerWaterVapor_[j] * 1000.0; // se multiplica por 10**3 por cuestión de unidades en las rutinas fortran.
+    wvt = wv * v_layerTemperature_[j] / 217.0; // v_layerWaterVapor_[j] está en kg/m**3
 
-    /*       TO BE IMPLEMENTED IN NEXT RELEASE
+    (*v_NPtr[0])[j] = atm.getRefractivity_o2(v_layerTemperature_[j],
+                                             v_layerPressure_[j],
+                                             wvt,
+                                             nu);     // ,width,npoints)); TO BE IMPLEMENTED IN NEXT RELEASE
 
-    if (v_chanFreq_.size()>1){
-      if(nc==0){
-	width = fabs(v_chanFreq_[nc+1]-v_chanFreq_[nc])*1e-9;       // width en GHz para ATM
-	npoints=(unsigned int)round(width*100);                     // One point every 10 MHz
-      }else{
-	if(nc==v_chanFreq_.size()-1){
-	  width = fabs(v_chanFreq_[nc]-v_chanFreq_[nc-1])*1e-9;     // width en GHz para ATM
-	  npoints=(unsigned int)round(width*100);                   // One point every 10 MHz 
-	}else{
-	  width = fabs((v_chanFreq_[nc+1]-v_chanFreq_[nc-1])/2.0)*1e-9;    // width en GHz para ATM
-	  npoints=(unsigned int)round(width*100);                          // One point every 10 MHz
-	}
-      }
-    }else{
-      width = 0.001;      // default width = 1 MHz = 0.001 GHz
-      npoints=1;
+    (*v_NPtr[1])[j] = atm.getSpecificRefractivity_cnth2o(v_layerTemperature_[j],
+                                                         v_layerPressure_[j],
+                                                         wvt,
+                                                         nu);     // ,width,npoints); TO BE IMPLEMENTED IN NEXT RELEASE
+    (*v_NPtr[2])[j] = atm.getSpecificRefractivity_cntdry(v_layerTemperature_[j],
+                                                         v_layerPressure_[j],
+                                                         wvt,
+                                                         nu);     // ,width,npoints); TO BE IMPLEMENTED IN NEXT RELEASE
+
+    if(v_layerWaterVapor_[j] > 0) {
+      (*v_NPtr[3])[j] = atm.getRefractivity_h2o(v_layerTemperature_[j],
+                                                v_layerPressure_[j],
+                                                wvt,
+                                                nu); // ,width,npoints)); TO BE IMPLEMENTED IN NEXT RELEASE
+    } else {
+      (*v_NPtr[3])[j] = 0.0;
     }
 
-    if(npoints==0){npoints=1;}
-
-    */
-
-
-
-    // cout << "nc =" << nc << " nu=" << nu << " width=" << width << " GHz    npoints=" << npoints << endl;
-
-    // nu2 = nu * nu;      // [-Wunused_but_set_variable]
-    // nu_pi = nu / M_PI;    // [-Wunused_but_set_variable] 
-
-    for(unsigned int j = 0; j < numLayer_; j++) {
-
-      wv = v_layerWaterVapor_[j] * 1000.0; // se multiplica por 10**3 por cuestión de unidades en las rutinas fortran.
-      wvt = wv * v_layerTemperature_[j] / 217.0; // v_layerWaterVapor_[j] está en kg/m**3
-      // t = v_layerTemperature_[j] / 300.0;    // [-Wunused_but_set_variable] 
-
-
-      // cout <<"ATMRefractiveIndexProfile: " << v_layerTemperature_[j] << " K " << v_layerPressure_[j] << " mb "  << nu << " GHz " << endl;
-      // cout <<"ATMRefractiveIndexProfile: O2" <<  atm.getRefractivity_o2(v_layerTemperature_[j],v_layerPressure_[j],wvt,nu) << endl;
-      // cout << "ATMRefractiveIndexProfile: O2" << atm.getRefractivity_o2(v_layerTemperature_[j],v_layerPressure_[j],wvt,nu,width,npoints) << endl;
-      // cout << "ATMRefractiveIndexProfile: H2O" << atm.getRefractivity_h2o(v_layerTemperature_[j],v_layerPressure_[j],wvt,nu) << endl;
-      // cout << "ATMRefractiveIndexProfile: H2O" << atm.getRefractivity_h2o(v_layerTemperature_[j],v_layerPressure_[j],wvt,nu,width,npoints) << endl;
-      // cout <<"ATMRefractiveIndexProfile: O3" <<  atm.getRefractivity_o3(v_layerTemperature_[j],v_layerPressure_[j],nu,v_layerO3_[j]) << endl;
-      // cout << "ATMRefractiveIndexProfile: O3" << atm.getRefractivity_o3(v_layerTemperature_[j],v_layerPressure_[j],nu,width,npoints,v_layerO3_[j]) << endl;      
-      // cout <<"ATMRefractiveIndexProfile: CO" <<  atm.getSpecificRefractivity_co(v_layerTemperature_[j],v_layerPressure_[j],nu) << endl;
-      // cout << "ATMRefractiveIndexProfile: CO" << atm.getSpecificRefractivity_co(v_layerTemperature_[j],v_layerPressure_[j],nu,width,npoints) << endl;
+    if(v_layerO3_[j] > 0) {
+      abun_O3 = v_layerO3_[j] * 1E-6;
+      (*v_NPtr[4])[j] = atm.getRefractivity_o3(v_layerTemperature_[j],
+                                               v_layerPressure_[j],
+                                               nu,      // width,npoints, TO BE IMPLEMENTED IN NEXT RELEASE
+                                               abun_O3 * 1e6);
+    } else {
+      (*v_NPtr[4])[j] = 0.0;
+    }
 
-      v_N_O2LinesPtr->push_back(atm.getRefractivity_o2(v_layerTemperature_[j],
+    if(v_layerCO_[j] > 0) {
+      abun_CO = v_layerCO_[j] * 1E-6; // in cm^-3
+      (*v_NPtr[5])[j] = atm.getSpecificRefractivity_co(v_layerTemperature_[j],
                                                        v_layerPressure_[j],
-                                                       wvt,
-                                                       nu));     // ,width,npoints)); TO BE IMPLEMENTED IN NEXT RELEASE
-
-      complex<double> cont_h2o =
-        atm.getSpecificRefractivity_cnth2o(v_layerTemperature_[j],
-                                           v_layerPressure_[j],
-                                           wvt,
-                                           nu);                   // ,width,npoints); TO BE IMPLEMENTED IN NEXT RELEASE
-      complex<double> cont_dry =
-          atm.getSpecificRefractivity_cntdry(v_layerTemperature_[j],
-                                             v_layerPressure_[j],
-                                             wvt,
-                                             nu);                  // ,width,npoints); TO BE IMPLEMENTED IN NEXT RELEASE
-
-      v_N_H2OContPtr->push_back(cont_h2o);
-      v_N_DryContPtr->push_back(cont_dry);
+                                                       nu)            // ,width,npoints) TO BE IMPLEMENTED IN NEXT RELEASE
+                        * abun_CO * 1e6; // m^2 * m^-3 = m^-1
+    } else {
+      (*v_NPtr[5])[j] = 0.0;
+    }
 
-      if(v_layerWaterVapor_[j] > 0) {
+    if(v_layerN2O_[j] > 0) {
+      abun_N2O = v_layerN2O_[j] * 1E-6;
+      (*v_NPtr[6])[j] = atm.getSpecificRefractivity_n2o(v_layerTemperature_[j],
+                                                        v_layerPressure_[j],
+                                                        nu)             // ,width,npoints) TO BE IMPLEMENTED IN NEXT RELEASE
+                        * abun_N2O * 1e6; // m^2 * m^-3 = m^-1
+    } else {
+      (*v_NPtr[6])[j] = 0.0;
+    }
 
-        v_N_H2OLinesPtr->push_back(atm.getRefractivity_h2o(v_layerTemperature_[j],
-                                                           v_layerPressure_[j],
-                                                           wvt,
-                                                           nu)); // ,width,npoints)); TO BE IMPLEMENTED IN NEXT RELEASE
-      } else {
-        v_N_H2OLinesPtr->push_back(0.0);
-      }
+    if(v_layerNO2_[j] > 0) {
+      abun_NO2 = v_layerNO2_[j] * 1E-6;
+      (*v_NPtr[7])[j] = atm.getSpecificRefractivity_no2(v_layerTemperature_[j],
+                                                        v_layerPressure_[j],
+                                                        nu)             // ,width,npoints) TO BE IMPLEMENTED IN NEXT RELEASE
+                        * abun_NO2 * 1e6; // m^2 * m^-3 = m^-1
+    } else {
+      (*v_NPtr[7])[j] = 0.0;
+    }
 
-      //	if(v_layerO3_[j]<0.0||j==10){cout << "v_layerO3_[" << j << "]=" << v_layerO3_[j] << endl;}
+    if(v_layerSO2_[j] > 0) {
+      abun_SO2 = v_layerSO2_[j] * 1E-6;
+      (*v_NPtr[8])[j] = atm.getSpecificRefractivity_so2(v_layerTemperature_[j],
+                                                        v_layerPressure_[j],
+                                                        nu)            // ,width,npoints) TO BE IMPLEMENTED IN NEXT RELEASE
+                        * abun_SO2 * 1e6; // m^2 * m^-3 = m^-1
+    } else {
+      (*v_NPtr[8])[j] = 0.0;
+    }
+  }
+}
 
-      if(v_layerO3_[j] > 0) {
+void RefractiveIndexProfile::mkRefractiveIndexProfile()
+{
 
-        abun_O3 = v_layerO3_[j] * 1E-6;
-        v_N_O3LinesPtr->push_back(atm.getRefractivity_o3(v_layerTemperature_[j],
-                                                         v_layerPressure_[j],
-                                                         nu,      // width,npoints, TO BE IMPLEMENTED IN NEXT RELEASE
-                                                         abun_O3 * 1e6));
-      } else {
-        v_N_O3LinesPtr->push_back(0.0);
-      }
+  //    static const double abun_18o=0.0020439;
+  //    static const double abun_17o=0.0003750;
+  //    static const double abun_D=0.000298444;
+  //    static const double o2_mixing_ratio=0.2092;
+  //    static const double mmol_h2o=18.005059688;  //   20*0.0020439+19*(0.0003750+2*0.000298444)+18*(1-0.0020439-0.0003750-2*0.000298444)
 
-      if(v_layerCO_[j] > 0) {
-        abun_CO = v_layerCO_[j] * 1E-6; // in cm^-3
-        v_N_COLinesPtr->push_back(atm.getSpecificRefractivity_co(v_layerTemperature_[j],
-								 v_layerPressure_[j],
-								 nu)            // ,width,npoints) TO BE IMPLEMENTED IN NEXT RELEASE
-				  * abun_CO * 1e6); // m^2 * m^-3 = m^-1
-        } else {
-        v_N_COLinesPtr->push_back(0.0);
-      }
+  //TODO we will have to put numLayer_ and v_chanFreq_.size() const
+  //we do not want to resize! ==> pas de setter pour SpectralGrid
 
-      if(v_layerN2O_[j] > 0) {
-        abun_N2O = v_layerN2O_[j] * 1E-6;
-        v_N_N2OLinesPtr->push_back(atm.getSpecificRefractivity_n2o(v_layerTemperature_[j],
-								   v_layerPressure_[j],
-								   nu)             // ,width,npoints) TO BE IMPLEMENTED IN NEXT RELEASE
-				   * abun_N2O * 1e6); // m^2 * m^-3 = m^-1
-        } else {
-        v_N_N2OLinesPtr->push_back(0.0);
-      }
+  // check if new spectral windows have been added
+  unsigned int ncmin = vv_N_H2OLinesPtr_.size(); // will be > 0 if spectral window(s) have been added
+  if(newBasicParam_) ncmin = 0;
 
-      if(v_layerNO2_[j] > 0) {
-        abun_NO2 = v_layerNO2_[j] * 1E-6;
-        v_N_NO2LinesPtr->push_back(atm.getSpecificRefractivity_no2(v_layerTemperature_[j],
-								   v_layerPressure_[j],
-								   nu)             // ,width,npoints) TO BE IMPLEMENTED IN NEXT RELEASE
-				   * abun_NO2 * 1e6); // m^2 * m^-3 = m^-1
-      } else {
-        v_N_NO2LinesPtr->push_back(0.0);
-      }
+  unsigned int numChan = v_chanFreq_.size();
+  unsigned int numOld = vv_N_H2OLinesPtr_.size();
+
+  vector<vector<complex<double> >*>* vvPtr[9] = { &vv_N_O2LinesPtr_,
+                                                  &vv_N_H2OContPtr_,
+                                                  &vv_N_DryContPtr_,
+                                                  &vv_N_H2OLinesPtr_,
+                                                  &vv_N_O3LinesPtr_,
+                                                  &vv_N_COLinesPtr_,
+                                                  &vv_N_N2OLinesPtr_,
+                                                  &vv_N_NO2LinesPtr_,
+                                                  &vv_N_SO2LinesPtr_ };
+
+  // delete the layer profiles which are going to be rebuilt (all of them if there are new basic param)
+  // and allocate the ones of the new frequency points, so that every channel can be filled independently
+  for(unsigned int n = 0; n < 9; n++) {
+    for(unsigned int nc = ncmin; nc < numOld && nc < numChan; nc++) {
+      delete (*vvPtr[n])[nc];
+      (*vvPtr[n])[nc] = new vector<complex<double> >;
+    }
+    vvPtr[n]->reserve(numChan);
+    for(unsigned int nc = numOld; nc < numChan; nc++) {
+      vvPtr[n]->push_back(new vector<complex<double> >);
+    }
+  }
 
-      if(v_layerSO2_[j] > 0) {
-        abun_SO2 = v_layerSO2_[j] * 1E-6;
-        v_N_SO2LinesPtr->push_back(atm.getSpecificRefractivity_so2(v_layerTemperature_[j],
-								   v_layerPressure_[j],
-								   nu)            // ,width,npoints) TO BE IMPLEMENTED IN NEXT RELEASE
-				   * abun_SO2 * 1e6); // m^2 * m^-3 = m^-1
+  if(ncmin >= numChan) {
+    newBasicParam_ = false;
+    return;
+  }
+
+  // the layer profiles of a channel depend only on its frequency and on the P/T/gas profile:
+  // look first in the cache for channels already computed with an identical atmosphere
+  vector<double> profileKey;
+  profileKey.reserve(8 * numLayer_ + 1);
+  profileKey.push_back(numLayer_);
+  profileKey.insert(profileKey.end(), v_layerTemperature_.begin(), v_layerTemperature_.begin() + numLayer_);
+  profileKey.insert(profileKey.end(), v_layerPressure_.begin(), v_layerPressure_.begin() + numLayer_);
+  profileKey.insert(profileKey.end(), v_layerWaterVapor_.begin(), v_layerWaterVapor_.begin() + numLayer_);
+  profileKey.insert(profileKey.end(), v_layerO3_.begin(), v_layerO3_.begin() + numLayer_);
+  profileKey.insert(profileKey.end(), v_layerCO_.begin(), v_layerCO_.begin() + numLayer_);
+  profileKey.insert(profileKey.end(), v_layerN2O_.begin(), v_layerN2O_.begin() + numLayer_);
+  profileKey.insert(profileKey.end(), v_layerNO2_.begin(), v_layerNO2_.begin() + numLayer_);
+  profileKey.insert(profileKey.end(), v_layerSO2_.begin(), v_layerSO2_.begin() + numLayer_);
+
+  vector<unsigned int> v_toCompute;
+  v_toCompute.reserve(numChan - ncmin);
+  {
+    RefractiveIndexProfileCache &cache = RefractiveIndexProfileCache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex_);
+    RefractiveIndexProfileCache::ChannelMap *channels = cache.find(profileKey);
+    for(unsigned int nc = ncmin; nc < numChan; nc++) {
+      RefractiveIndexProfileCache::ChannelMap::const_iterator it;
+      if(channels != 0 && (it = channels->find(v_chanFreq_[nc])) != channels->end()) {
+        for(unsigned int n = 0; n < 9; n++) *(*vvPtr[n])[nc] = it->second[n];
       } else {
-        v_N_SO2LinesPtr->push_back(0.0);
+        v_toCompute.push_back(nc);
       }
     }
+  }
 
-    // if(vv_N_H2OLinesPtr_.size() == 0) first = true;  // [-Wunused_but_set_variable]
-
-    if(vv_N_H2OLinesPtr_.size() < v_chanFreq_.size()) {
-      vv_N_H2OLinesPtr_.push_back(v_N_H2OLinesPtr);
-      vv_N_H2OContPtr_.push_back(v_N_H2OContPtr);
-      vv_N_O2LinesPtr_.push_back(v_N_O2LinesPtr);
-      vv_N_DryContPtr_.push_back(v_N_DryContPtr);
-      vv_N_O3LinesPtr_.push_back(v_N_O3LinesPtr);
-      vv_N_COLinesPtr_.push_back(v_N_COLinesPtr);
-      vv_N_N2OLinesPtr_.push_back(v_N_N2OLinesPtr);
-      vv_N_NO2LinesPtr_.push_back(v_N_NO2LinesPtr);
-      vv_N_SO2LinesPtr_.push_back(v_N_SO2LinesPtr);
-    } else {
-      vv_N_H2OLinesPtr_[nc] = v_N_H2OLinesPtr;
-      vv_N_H2OContPtr_[nc] = v_N_H2OContPtr;
-      vv_N_O2LinesPtr_[nc] = v_N_O2LinesPtr;
-      vv_N_DryContPtr_[nc] = v_N_DryContPtr;
-      vv_N_O3LinesPtr_[nc] = v_N_O3LinesPtr;
-      vv_N_COLinesPtr_[nc] = v_N_COLinesPtr;
-      vv_N_N2OLinesPtr_[nc] = v_N_N2OLinesPtr;
-      vv_N_NO2LinesPtr_[nc] = v_N_NO2LinesPtr;
-      vv_N_SO2LinesPtr_[nc] = v_N_SO2LinesPtr;
+  // every (channel, layer) block is independent: distribute the channels over the threads
+  int numToCompute = v_toCompute.size();
+#pragma omp parallel for schedule(dynamic)
+  for(int i = 0; i < numToCompute; i++) {
+    unsigned int nc = v_toCompute[i];
+    vector<complex<double> >* v_NPtr[9];
+    for(unsigned int n = 0; n < 9; n++) v_NPtr[n] = (*vvPtr[n])[nc];
+    mkRefractiveIndexChannel(1.0E-9 * v_chanFreq_[nc], v_NPtr); // ATM uses GHz units
+  }
+
+  if(numToCompute > 0) {
+    RefractiveIndexProfileCache &cache = RefractiveIndexProfileCache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex_);
+    RefractiveIndexProfileCache::ChannelMap &channels = cache.insert(profileKey);
+    for(int i = 0; i < numToCompute; i++) {
+      unsigned int nc = v_toCompute[i];
+      vector<vector<complex<double> > > &entry = channels[v_chanFreq_[nc]];
+      entry.resize(9);
+      for(unsigned int n = 0; n < 9; n++) entry[n] = *(*vvPtr[n])[nc];
     }
-
   }
 
   newBasicParam_ = false;
-  // first = false;  // [-Wunused_but_set_variable]
 }
 
 Opacity RefractiveIndexProfile::getDryOpacity()
@@ -873,6 +873,11 @@ protected:
    * Method to build the profile of the absorption coefficients,
    */
   void mkRefractiveIndexProfile(); //!<  builds the absorption profiles, returns error code: <0 unsuccessful
+  /**
+   * Method to build the layer profiles of the 9 absorption coefficients for a single frequency (GHz).
+   * It does not modify the object, hence it can be called concurrently for different channels.
+   */
+  void mkRefractiveIndexChannel(double nu, vector<std::complex<double> >* const v_NPtr[9]) const;
   void rmRefractiveIndexProfile(); //!<  deletes all the layer profiles for all the frequencies
 
   bool updateRefractiveIndexProfile(const Length &altitude,
@@ -976,6 +976,14 @@ bool TBArrayData::isLoaded() { return loaded; }
 
 bool TBArrayData::isOneDimensional() { return oneDim; }
 
+void TBArrayData::setUnloadedShape(const IPosition& s) {
+    shape.resize(s.size());
+    for(unsigned int i = 0; i < s.size(); i++)
+        shape[i] = s[i];
+    loaded = false;
+    oneDim = shape.size() == 1;
+}
+
 // Public Methods //
 
 bool TBArrayData::coordIsValid(vector<int> d) { 
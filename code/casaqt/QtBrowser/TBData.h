@@ -996,6 +996,10 @@ public:
     
     // Returns true if the array is one-dimensional, false otherwise.
     bool isOneDimensional();
+
+    // Sets the shape of an array whose data is not loaded.  Used by the
+    // table drivers to describe multi-dimensional cells without reading them.
+    void setUnloadedShape(const casacore::IPosition& s);
     
     // Returns true if the given coordinate is a valid index for this array
     // given its shape, false otherwise.
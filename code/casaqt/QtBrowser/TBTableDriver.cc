@@ -43,6 +43,7 @@
 #include <tables/Tables/TableColumn.h>
 #include <casa/Containers/RecordField.h>
 #include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Slicer.h>
 #include <casa/Exceptions/Error.h>
 
 #include <sstream>
@@ -109,6 +110,46 @@ Result TBTableDriver::query(String type, String query) {
 // TBTABLEDRIVERDIRECT DEFINITIONS //
 /////////////////////////////////////
 
+// Reads rows [start, start + n) of the given scalar column with a single
+// column access and puts them into column j of the given data rows.
+template <class T, class D>
+static void loadScalarColumn(const Table& table, const String& name,
+                             unsigned int j, int start, int n,
+                             vector<vector<TBData*>*>& rows) {
+    ROScalarColumn<T> col(table, name);
+    Vector<T> v = col.getColumnRange(Slicer(IPosition(1, start),
+                                            IPosition(1, n)));
+    for(int i = 0; i < n; i++)
+        rows[i]->at(j) = new D(v(i));
+}
+
+// Reads rows [start, start + n) of the given array column into column j of
+// the given data rows.  Unless full is true, only the shapes of
+// multi-dimensional cells are read; their data is loaded on demand (see
+// TBTableDriverDirect::loadArray()).
+template <class T, class D>
+static void loadArrayColumn(const Table& table, const String& name,
+                            unsigned int j, int start, int n, bool full,
+                            vector<vector<TBData*>*>& rows) {
+    ROArrayColumn<T> col(table, name);
+    for(int i = 0; i < n; i++) {
+        int r = start + i;
+        D* val;
+        if(!col.isDefined(r)) {
+            val = new D(Array<T>(), full);
+        } else {
+            IPosition shape = col.shape(r);
+            if(full || shape.size() == 1) {
+                val = new D(col(r), full);
+            } else {
+                val = new D();
+                val->setUnloadedShape(shape);
+            }
+        }
+        rows[i]->at(j) = val;
+    }
+}
+
 // Constructors/Destructors //
 
 TBTableDriverDirect::TBTableDriverDirect(TableParams* tp, TBTable* t) :
@@ -233,7 +274,6 @@ Result TBTableDriverDirect::loadRows(int start, int num, bool full,
     ROTableRow row(table);
     Vector<String> colNames = row.columnNames();
     TableDesc tdesc = table.tableDesc();
-    void** fieldPtrs = (void**) new unsigned int*[colNames.nelements()];
 
     bool updateFields = colNames.nelements() != fields.size();
     if(updateFields) {
@@ -252,69 +292,15 @@ Result TBTableDriverDirect::loadRows(int start, int num, bool full,
         DataType t = row.record().type(row.record().fieldNumber(colNames(i)));
         String type = TBConstants::typeName(t);
 
-        bool valid = true;
-        if(t == TpString)
-            fieldPtrs[i] = new RORecordFieldPtr<String>(row.record(),
-                                                        colNames(i));
-        else if(t == TpInt)
-            fieldPtrs[i] = new RORecordFieldPtr<Int>(row.record(),
-                                                     colNames(i));
-        else if(t == TpFloat)
-            fieldPtrs[i] = new RORecordFieldPtr<Float>(row.record(),
-                                                       colNames(i));
-        else if(t == TpDouble)
-            fieldPtrs[i] = new RORecordFieldPtr<Double>(row.record(),
-                                                        colNames(i));
-        else if(t == TpBool)
-            fieldPtrs[i] = new RORecordFieldPtr<Bool>(row.record(),
-                                                      colNames(i));
-        else if(t == TpUChar)
-            fieldPtrs[i] = new RORecordFieldPtr<uChar>(row.record(),
-                                                       colNames(i));
-        else if(t == TpShort)
-            fieldPtrs[i] = new RORecordFieldPtr<Short>(row.record(),
-                                                       colNames(i));
-        else if(t == TpUInt)
-            fieldPtrs[i] = new RORecordFieldPtr<uInt>(row.record(),
-                                                      colNames(i));
-        else if(t == TpComplex)
-            fieldPtrs[i] = new RORecordFieldPtr<Complex>(row.record(),
-                                                         colNames(i));
-        else if(t == TpDComplex)
-            fieldPtrs[i] = new RORecordFieldPtr<DComplex>(row.record(),
-                                                          colNames(i));
-        else if(t == TpArrayDouble)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<Double> >(row.record(),
-                                                                colNames(i));
-        else if(t == TpArrayBool)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<Bool> >(row.record(),
-                                                              colNames(i));
-        else if(t == TpArrayUChar)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<uChar> >(row.record(),
-                                                               colNames(i));
-        else if(t == TpArrayShort)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<Short> >(row.record(),
-                                                               colNames(i));
-        else if(t == TpArrayInt)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<Int> >(row.record(),
-                                                             colNames(i));
-        else if(t == TpArrayUInt)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<uInt> >(row.record(),
-                                                              colNames(i));
-        else if(t == TpArrayFloat)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<Float> >(row.record(),
-                                                               colNames(i));
-        else if(t == TpArrayComplex)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<Complex> >(row.record(),
-                                                                 colNames(i));
-        else if(t == TpArrayDComplex)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<DComplex> >(row.record(),
-                                                                  colNames(i));
-        else if(t == TpArrayString)
-            fieldPtrs[i] = new RORecordFieldPtr<Array<String> >(row.record(),
-                                                                colNames(i));
-        else {valid = false;
-	}
+        bool valid = t == TpString || t == TpInt || t == TpFloat ||
+                     t == TpDouble || t == TpBool || t == TpUChar ||
+                     t == TpShort || t == TpUInt || t == TpComplex ||
+                     t == TpDComplex || t == TpArrayDouble ||
+                     t == TpArrayBool || t == TpArrayUChar ||
+                     t == TpArrayShort || t == TpArrayInt ||
+                     t == TpArrayUInt || t == TpArrayFloat ||
+                     t == TpArrayComplex || t == TpArrayDComplex ||
+                     t == TpArrayString;
                 
         if(updateFields && t == TpDouble) { // Check if it's a date.
           String comment = cdesc.comment(); // Wouldn't it be better to look
@@ -398,113 +384,99 @@ Result TBTableDriverDirect::loadRows(int start, int num, bool full,
     data.clear();
     
     if(parsedata) {
-        for(int i = start; i < end; i++) {
-            row.get(i);
-
-            vector<TBData*>* r2 = new vector<TBData*>();
-            for(unsigned int j = 0; j < colNames.nelements(); j++) {
-                DataType t = row.record().type(j);
-
-                TBData* val = NULL;
-                if(t == TpString) {
-                    val = new TBDataString(**((RORecordFieldPtr<String>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpFloat) {
-                    val = new TBDataFloat(**((RORecordFieldPtr<Float>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpInt) {
-                    val = new TBDataInt(**((RORecordFieldPtr<Int>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpDouble) {
-                    String comment = tdesc.columnDesc(j).comment();
-                    double v = **((RORecordFieldPtr<Double>*)fieldPtrs[j]);
-                    if(TBConstants::equalsIgnoreCase(comment,
-                                                     TBConstants::COMMENT_DATE) ||
-                       TBConstants::equalsIgnoreCase(comment,
-                                                     TBConstants::COMMENT_TIMP) ||
-                       TBConstants::equalsIgnoreCase(comment,
-                                                     TBConstants::COMMENT_TIMP2)) {
-                        val = new TBDataDate(v);
-                    } else {
-                        val = new TBDataDouble(v);
-                    }
-                } else if(t == TpBool) {
-                    val = new TBDataBool(**((RORecordFieldPtr<Bool>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpChar) {
-                    val = new TBDataChar(**((RORecordFieldPtr<Char>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpUChar) {
-                    val = new TBDataUChar(**((RORecordFieldPtr<uChar>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpShort) {
-                    val = new TBDataShort(**((RORecordFieldPtr<Short>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpUInt) {
-                    val = new TBDataUInt(**((RORecordFieldPtr<uInt>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpComplex) {
-                    val = new TBDataComplex(**((RORecordFieldPtr<Complex>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpDComplex) {
-                    val = new TBDataDComplex(**((RORecordFieldPtr<DComplex>*)
-                                           fieldPtrs[j]));
-                } else if(t == TpArrayDouble) {
-                    val = new TBArrayDataDouble(
-                              **((RORecordFieldPtr<Array<Double> >*)
-                                 fieldPtrs[j]), full);
-                } else if(t == TpArrayBool) {
-                    val = new TBArrayDataBool(
-                              **((RORecordFieldPtr<Array<Bool> >*)
-                                 fieldPtrs[j]), full);
-                } else if(t == TpArrayUChar) {
-                    val = new TBArrayDataUChar(
-                              **((RORecordFieldPtr<Array<uChar> >*)
-                                      fieldPtrs[j]), full);
-                } else if(t == TpArrayChar) {
-                    val = new TBArrayDataChar(
-                              **((RORecordFieldPtr<Array<Char> >*)
-                                 fieldPtrs[j]));
-                } else if(t == TpArrayShort) {
-                    val = new TBArrayDataShort(
-                              **((RORecordFieldPtr<Array<Short> >*)
-                                      fieldPtrs[j]), full);
-                } else if(t == TpArrayInt) {
-                    val = new TBArrayDataInt(
-                              **((RORecordFieldPtr<Array<Int> >*)
-                                      fieldPtrs[j]), full);
-                } else if(t == TpArrayUInt) {
-                    val = new TBArrayDataUInt(
-                              **((RORecordFieldPtr<Array<uInt> >*)
-                                      fieldPtrs[j]), full);
-                } else if(t == TpArrayFloat) {
-                    val = new TBArrayDataFloat(
-                              **((RORecordFieldPtr<Array<Float> >*)
-                                      fieldPtrs[j]), full);
-                } else if(t == TpArrayComplex) {
-                    val = new TBArrayDataComplex(
-                              **((RORecordFieldPtr<Array<Complex> >*)
-                                      fieldPtrs[j]), full);
-                } else if(t == TpArrayDComplex) {
-                    val = new TBArrayDataDComplex(
-                              **((RORecordFieldPtr<Array<DComplex> >*)
-                                      fieldPtrs[j]), full);
-                } else if(t == TpArrayString) {
-                    val = new TBArrayDataString(
-                              **((RORecordFieldPtr<Array<String> >*)
-                                      fieldPtrs[j]), full);
+        // Read the requested rows column by column, with one table access
+        // per column instead of one record per row, and without reading
+        // the data of multi-dimensional array cells unless full is set.
+        int n = end - start;
+        for(int i = 0; i < n; i++)
+            data.push_back(new vector<TBData*>(colNames.nelements(), NULL));
+
+        int rowSteps = n / 10, stepsDone = 0;
+        for(unsigned int j = 0; j < colNames.nelements(); j++) {
+            DataType t = row.record().type(j);
+            const String& name = colNames(j);
+
+            if(t == TpString) {
+                loadScalarColumn<String, TBDataString>(table, name, j, start,
+                                                       n, data);
+            } else if(t == TpFloat) {
+                loadScalarColumn<Float, TBDataFloat>(table, name, j, start, n,
+                                                     data);
+            } else if(t == TpInt) {
+                loadScalarColumn<Int, TBDataInt>(table, name, j, start, n,
+                                                 data);
+            } else if(t == TpDouble) {
+                String comment = tdesc.columnDesc(j).comment();
+                if(TBConstants::equalsIgnoreCase(comment,
+                                                 TBConstants::COMMENT_DATE) ||
+                   TBConstants::equalsIgnoreCase(comment,
+                                                 TBConstants::COMMENT_TIMP) ||
+                   TBConstants::equalsIgnoreCase(comment,
+                                                 TBConstants::COMMENT_TIMP2)) {
+                    loadScalarColumn<Double, TBDataDate>(table, name, j,
+                                                         start, n, data);
+                } else {
+                    loadScalarColumn<Double, TBDataDouble>(table, name, j,
+                                                           start, n, data);
                 }
-                
-                r2->push_back(val);
+            } else if(t == TpBool) {
+                loadScalarColumn<Bool, TBDataBool>(table, name, j, start, n,
+                                                   data);
+            } else if(t == TpUChar) {
+                loadScalarColumn<uChar, TBDataUChar>(table, name, j, start, n,
+                                                     data);
+            } else if(t == TpShort) {
+                loadScalarColumn<Short, TBDataShort>(table, name, j, start, n,
+                                                     data);
+            } else if(t == TpUInt) {
+                loadScalarColumn<uInt, TBDataUInt>(table, name, j, start, n,
+                                                   data);
+            } else if(t == TpComplex) {
+                loadScalarColumn<Complex, TBDataComplex>(table, name, j,
+                                                         start, n, data);
+            } else if(t == TpDComplex) {
+                loadScalarColumn<DComplex, TBDataDComplex>(table, name, j,
+                                                           start, n, data);
+            } else if(t == TpArrayDouble) {
+                loadArrayColumn<Double, TBArrayDataDouble>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayBool) {
+                loadArrayColumn<Bool, TBArrayDataBool>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayUChar) {
+                loadArrayColumn<uChar, TBArrayDataUChar>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayShort) {
+                loadArrayColumn<Short, TBArrayDataShort>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayInt) {
+                loadArrayColumn<Int, TBArrayDataInt>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayUInt) {
+                loadArrayColumn<uInt, TBArrayDataUInt>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayFloat) {
+                loadArrayColumn<Float, TBArrayDataFloat>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayComplex) {
+                loadArrayColumn<Complex, TBArrayDataComplex>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayDComplex) {
+                loadArrayColumn<DComplex, TBArrayDataDComplex>(table, name, j,
+                                                     start, n, full, data);
+            } else if(t == TpArrayString) {
+                loadArrayColumn<String, TBArrayDataString>(table, name, j,
+                                                     start, n, full, data);
             }
-            data.push_back(r2);
-            loadedRows++;
 
-            if(pp != NULL && ((i - start) % 10) == 0) pp->step();
+            if(pp != NULL) {
+                int s = (rowSteps * (j + 1)) / colNames.nelements();
+                for(; stepsDone < s; stepsDone++) pp->step();
+            }
         }
+        loadedRows = n;
     }
 
-    delete [] fieldPtrs;
     if(pp != NULL) pp->done();
     return Result("", true);
 
@@ -521,44 +493,44 @@ void TBTableDriverDirect::loadArray(TBArrayData* d, unsigned int r,
     
     Table table = m_table;
 
-    ROTableRow row(table);
-    row.get(r);
-    
-    DataType t = row.record().type(c);
+    // Read only the requested cell rather than the whole row.
+    TableColumn column(table, c);
+    DataType t = column.columnDesc().trueDataType();
+    String name = column.columnDesc().name();
 
     if(t == TpArrayDouble) {
-        RORecordFieldPtr<Array<Double> > p(row.record(), c);
-        ((TBArrayDataDouble*)d)->load(*p);
+        ROArrayColumn<Double> p(table, name);
+        ((TBArrayDataDouble*)d)->load(p(r));
     } else if(t == TpArrayBool) {
-        RORecordFieldPtr<Array<Bool> > p(row.record(), c);
-        ((TBArrayDataBool*)d)->load(*p);
+        ROArrayColumn<Bool> p(table, name);
+        ((TBArrayDataBool*)d)->load(p(r));
     } else if(t == TpArrayChar) {
-        RORecordFieldPtr<Array<Char> > p(row.record(), c);
-        ((TBArrayDataChar*)d)->load(*p);
+        ROArrayColumn<Char> p(table, name);
+        ((TBArrayDataChar*)d)->load(p(r));
     } else if(t == TpArrayUChar) {
-        RORecordFieldPtr<Array<uChar> > p(row.record(), c);
-        ((TBArrayDataUChar*)d)->load(*p);
+        ROArrayColumn<uChar> p(table, name);
+        ((TBArrayDataUChar*)d)->load(p(r));
     } else if(t == TpArrayShort) {
-        RORecordFieldPtr<Array<Short> > p(row.record(), c);
-        ((TBArrayDataShort*)d)->load(*p);
+        ROArrayColumn<Short> p(table, name);
+        ((TBArrayDataShort*)d)->load(p(r));
     } else if(t == TpArrayInt) {
-        RORecordFieldPtr<Array<Int> > p(row.record(), c);
-        ((TBArrayDataInt*)d)->load(*p);
+        ROArrayColumn<Int> p(table, name);
+        ((TBArrayDataInt*)d)->load(p(r));
     } else if(t == TpArrayUInt) {
-        RORecordFieldPtr<Array<uInt> > p(row.record(), c);
-        ((TBArrayDataUInt*)d)->load(*p);
+        ROArrayColumn<uInt> p(table, name);
+        ((TBArrayDataUInt*)d)->load(p(r));
     } else if(t == TpArrayFloat) {
-        RORecordFieldPtr<Array<Float> > p(row.record(), c);
-        ((TBArrayDataFloat*)d)->load(*p);
+        ROArrayColumn<Float> p(table, name);
+        ((TBArrayDataFloat*)d)->load(p(r));
     } else if(t == TpArrayComplex) {
-        RORecordFieldPtr<Array<Complex> > p(row.record(), c);
-        ((TBArrayDataComplex*)d)->load(*p);
+        ROArrayColumn<Complex> p(table, name);
+        ((TBArrayDataComplex*)d)->load(p(r));
     } else if(t == TpArrayDComplex) {
-        RORecordFieldPtr<Array<DComplex> > p(row.record(), c);
-        ((TBArrayDataDComplex*)d)->load(*p);
+        ROArrayColumn<DComplex> p(table, name);
+        ((TBArrayDataDComplex*)d)->load(p(r));
     } else if(t == TpArrayString) {
-        RORecordFieldPtr<Array<String> > p(row.record(), c);
-        ((TBArrayDataString*)d)->load(*p);
+        ROArrayColumn<String> p(table, name);
+        ((TBArrayDataString*)d)->load(p(r));
     }
 }
 
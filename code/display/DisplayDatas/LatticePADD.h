@@ -29,6 +29,7 @@
 #define TRIALDISPLAY_LATTICEPADD_H
 
 #include <casa/aips.h>
+#include <list>
 #include <casa/Quanta/Unit.h>
 #include <images/Images/ImageInterface.h>
 #include <display/DisplayDatas/PrincipalAxesDD.h>
@@ -149,6 +150,26 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 			return itsMaskedLatticePtr;
 		}
 
+		// Cache of the data slices extracted by the display methods, so that
+		// planes already displayed (e.g. when stepping back and forth through
+		// the channels of a cube) are not read again from the lattice.  The
+		// cache holds at most display.slicecache.size MB (aipsrc, default 256);
+		// the least recently used slices are dropped first.  It is cleared by
+		// cleanup() (i.e. by refresh(true) and the "reread" option), and
+		// when the data of a paged image have changed on disk.
+		// <group>
+		casacore::Bool getCachedSlice(casacore::Matrix<T>& data, casacore::Matrix<casacore::Bool>& mask,
+		                              const casacore::IPosition& start, const casacore::IPosition& sliceShape,
+		                              const casacore::IPosition& stride, casacore::Bool transposed);
+		void cacheSlice(const casacore::Matrix<T>& data, const casacore::Matrix<casacore::Bool>& mask,
+		                const casacore::IPosition& start, const casacore::IPosition& sliceShape,
+		                const casacore::IPosition& stride, casacore::Bool transposed);
+		void clearSliceCache();
+		// </group>
+
+		// tidy up the elements, and the slice cache
+		virtual void cleanup();
+
 
 		// Insert an array into a Record. The array is insert into a "value" field, eg
 		// somerecord.fieldname.value
@@ -250,6 +271,19 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// pointer to resampler
 		WCResampleHandler *itsResampleHandler;
 
+		// the slice cache, most recently used first
+		struct CachedSlice {
+			casacore::IPosition start, shape, stride;
+			casacore::Bool transposed;
+			casacore::Matrix<T> data;
+			casacore::Matrix<casacore::Bool> mask;
+		};
+		std::list<CachedSlice> itsSliceCache;
+
+		// true if the base image is a paged image whose data have changed on
+		// disk since this was last asked
+		casacore::Bool dataChangedOnDisk();
+
 		// update itsLatticeStatistics
 		void updateLatticeStatistics();
 
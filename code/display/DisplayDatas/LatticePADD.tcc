@@ -46,6 +46,7 @@
 #include <lattices/Lattices/LatticeLocker.h>
 #include <lattices/Lattices/SubLattice.h>
 #include <images/Images/ImageInterface.h>
+#include <images/Images/PagedImage.h>
 #include <display/Utilities/ImageProperties.h>
 #include <imageanalysis/ImageAnalysis/SubImageFactory.h>
 #include <images/Images/SubImage.h>
@@ -58,6 +59,7 @@
 #include <casa/Quanta/Unit.h>
 #include <casa/OS/RegularFile.h>
 #include <casa/OS/Directory.h>
+#include <casa/System/Aipsrc.h>
 #include <display/Display/WorldCanvas.h>
 
 
@@ -257,6 +259,85 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 
 
+	template <class T>
+	void LatticePADisplayData<T>::cleanup() {
+		clearSliceCache();
+		PrincipalAxesDD::cleanup();
+	}
+
+	template <class T>
+	casacore::Bool LatticePADisplayData<T>::getCachedSlice(casacore::Matrix<T>& data,
+	        casacore::Matrix<casacore::Bool>& mask,
+	        const casacore::IPosition& start,
+	        const casacore::IPosition& sliceShape,
+	        const casacore::IPosition& stride,
+	        casacore::Bool transposed) {
+		// The slices of an image rewritten on disk (e.g. by a clean running
+		// in another process) are stale.
+		if (dataChangedOnDisk()) clearSliceCache();
+		typename std::list<CachedSlice>::iterator iter;
+		for (iter = itsSliceCache.begin(); iter != itsSliceCache.end(); ++iter) {
+			if (iter->transposed == transposed && iter->start.isEqual(start) &&
+			        iter->shape.isEqual(sliceShape) && iter->stride.isEqual(stride)) {
+				// Copies, the callers may modify the matrices they get.
+				data.resize(iter->data.shape());
+				data = iter->data;
+				mask.resize(iter->mask.shape());
+				mask = iter->mask;
+				// Move to the front, as most recently used.
+				itsSliceCache.splice(itsSliceCache.begin(), itsSliceCache, iter);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <class T>
+	void LatticePADisplayData<T>::cacheSlice(const casacore::Matrix<T>& data,
+	        const casacore::Matrix<casacore::Bool>& mask,
+	        const casacore::IPosition& start,
+	        const casacore::IPosition& sliceShape,
+	        const casacore::IPosition& stride,
+	        casacore::Bool transposed) {
+		// Looked up each time, so that a change of the size is seen.
+		casacore::String value;
+		casacore::Aipsrc::find(value, "display.slicecache.size", "256");
+		casacore::Int budgetMB = atoi(value.chars());
+		size_t budget = size_t(budgetMB > 0 ? budgetMB : 1) * 1024 * 1024;
+		size_t bytes = data.nelements()*sizeof(T) + mask.nelements()*sizeof(casacore::Bool);
+		if (bytes > budget) return;
+
+		CachedSlice slice;
+		slice.start = start;
+		slice.shape = sliceShape;
+		slice.stride = stride;
+		slice.transposed = transposed;
+		slice.data = data.copy();
+		slice.mask = mask.copy();
+		itsSliceCache.push_front(slice);
+
+		// Drop the least recently used slices beyond the budget.
+		size_t total = 0;
+		typename std::list<CachedSlice>::iterator iter;
+		for (iter = itsSliceCache.begin(); iter != itsSliceCache.end(); ++iter) {
+			total += iter->data.nelements()*sizeof(T) + iter->mask.nelements()*sizeof(casacore::Bool);
+			if (total > budget) break;
+		}
+		itsSliceCache.erase(iter, itsSliceCache.end());
+	}
+
+	template <class T>
+	void LatticePADisplayData<T>::clearSliceCache() {
+		itsSliceCache.clear();
+	}
+
+	template <class T>
+	casacore::Bool LatticePADisplayData<T>::dataChangedOnDisk() {
+		casacore::PagedImage<T>* pagedImage =
+		    dynamic_cast<casacore::PagedImage<T>*>(itsBaseImagePtr.get());
+		return pagedImage != 0 && pagedImage->table().hasDataChanged();
+	}
+
 // Query the shape of the lattice
 	template <class T>
 	const casacore::IPosition LatticePADisplayData<T>::dataShape() const {
@@ -88,13 +88,19 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 	        const casacore::IPosition& start,
 	        const casacore::IPosition& sliceShape,
 	        const casacore::IPosition& stride) {
-		casacore::MaskedLattice<T>* latt =
-		    ((LatticePADisplayData<T> *)parentDisplayData())->maskedLattice().get();
+		LatticePADisplayData<T> *lpadd = (LatticePADisplayData<T> *)parentDisplayData();
+		casacore::MaskedLattice<T>* latt = lpadd->maskedLattice().get();
 		if (!latt) {
 			throw(casacore::AipsError("LatticePADisplayMethod<T>::dataGetSlice - "
 			                "no lattice is available"));
 		}
-		return dataGetSlice (data, mask, start, sliceShape, stride, *latt);
+		casacore::Bool transposed = needToTranspose();
+		if (lpadd->getCachedSlice(data, mask, start, sliceShape, stride, transposed)) {
+			return true;
+		}
+		casacore::Bool ok = dataGetSlice (data, mask, start, sliceShape, stride, *latt);
+		if (ok) lpadd->cacheSlice(data, mask, start, sliceShape, stride, transposed);
+		return ok;
 	}
 
 	template <class T>
@@ -53,6 +53,7 @@
 #include <display/Display/ColormapDefinition.h>
 #include <casa/Utilities/Regex.h>
 #include <casa/System/Aipsrc.h>
+#include <casa/System/AipsrcValue.h>
 #include <casa/Quanta/MVTime.h>
 #include <casa/BasicSL/Constants.h>
 #include <casa/OS/HostInfo.h>
@@ -149,6 +150,12 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		visDataChg_(true),
 		postDataRng_(false),
+		backgroundExtract_(true),
+		extracting_(false),
+		extractDone_(false),
+		extractCancel_(false),
+		loadVisType_(),
+		loadVisComp_(),
 
 		mspos_(this),
 
@@ -202,6 +209,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		msValid_ = true;		// (DD will do nothing unless this is true).
 
+		AipsrcValue<Bool>::find(backgroundExtract_, "display.msasraster.background", true);
+
 		// Initialize private colormap (for flags, etc.).
 
 		Vector<Float> r(NCOLORS), g(NCOLORS), b(NCOLORS);
@@ -373,7 +382,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 			}
 		}
 
-		itsMS->relinquishAutoLocks(true);	// (just to be sure).
+		if(!extracting_) itsMS->relinquishAutoLocks(true);	// (just to be sure).
+		// (Otherwise the extraction thread does it when done with the MS).
 	}
 
 
@@ -1451,6 +1461,13 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// draw_().
 
 		if(!msValid_) return false;	// In this case, the object is useless.
+
+		if(extracting_ && extractDone_) waitForExtract_();
+		// Complete a background extraction that has finished (this does
+		// not block).  One still running is left to run: only changes to
+		// what it loads (MS selection, baseline sort, visibility type or
+		// component) cancel it, below.  Other option changes, e.g. to the
+		// colormap, do not wait for it.
 		// Protect public methods from crashes.
 
 		static const Bool wholeRecord=true, overwrite=true;
@@ -1845,6 +1862,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// This work (which can take a little time on a large MS) is done here,
 		// so that any new axis ranges may be returned to the user interface.
 
+		if(newRanges || bslSortChg) waitForExtract_(false);
+		// A running extraction reads the MS selection and baseline
+		// indices changed below; it is abandoned, and restarted if needed.
+
 		if(newRanges) {
 
 
@@ -2018,6 +2039,15 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		if(dish_ && visComp_==AMPLITUDE) visComp_ = REAL;
 
+		if(extracting_ && (visType_!=loadVisType_ || visComp_!=loadVisComp_)) {
+			waitForExtract_(false);
+		}
+		// A running extraction of other visibilities is abandoned.
+
+		Bool loading = extracting_;
+		// Still true if the running extraction loads the data wanted now;
+		// vis_ is not valid until it ends, but it need not be restarted.
+
 		Bool isDev = (visDev_>NORMAL);
 		// whether we're [now] in deviation display mode.
 
@@ -2073,7 +2103,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// attempted in memory (loaded baselines would no longer be contiguous) --
 		// we'll throw in the towel and reload from scratch.
 
-		visDataChg_ = !visValid_ ||
+		// (While loading, visDataChg_ is left as extract_ found it; the
+		// extraction thread and finishExtract_ still use it.)
+
+		if(!loading) visDataChg_ = !visValid_ ||
 		              visType_!=curVisType_ ||
 		              visComp_!=curVisComp_ ||
 		              newRanges ||
@@ -2082,7 +2115,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		Bool shouldExtract = msselValid_ &&
 		                     ( applyPressed ||
-		                       (visDataChg_ && curVisComp_!=INVALID_VC) );
+		                       (!loading && visDataChg_ && curVisComp_!=INVALID_VC) );
 		// Reload of data from disk will automatically occur if
 		// desired vis_ data is not loaded, _except_ for the _first time_
 		// on a _really large_ MS (curVisComp_!=INVALID_VC indicates that
@@ -2095,7 +2128,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 			// (It usually is, but not if all the following
 			// conditions hold...).
 
-			if(!visDataChg_) {
+			if(loading || !visDataChg_) {
 				if(visShape_[axX]==msShape_[axX] && visShape_[axY]==msShape_[axY]) {
 					if(pos_[axSL0]>=visStart_[axSL0] &&
 					        pos_[axSL0]< visStart_[axSL0] + visShape_[axSL0] &&
@@ -2363,6 +2396,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		if(!msselValid_) return false;	// No data in [selected] MS.
 
+		if(extracting_) return false;	// vis_ is still being loaded; the
+		// viewer refreshes once finishExtraction() completes the load.
+
 		// The color wedge is no longer displayed for DisplayDatas whose
 		// state is something other than DISPLAYED...
 		setDisplayState( DisplayData::DISPLAYED );
@@ -2575,6 +2611,11 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		//       Requested visType_ and real visComp_.
 		//	   visDataChg_ ( == 'data ranges should be completely recalculated').
 		//
+		// With background extraction, the MS is read by loadVis_ on a worker
+		// thread, and finishExtract_ completes the output below on the GUI
+		// thread, when the viewer polls for the end of the extraction (see
+		// finishExtraction()).  Until then visValid_ is false.
+		//
 		// Output: vis_ (and corresp. vis_ state data: visValid_, curVisType_,
 		//	     curVisComp_, visShape_, visShapeA_, visStart_), which has the
 		//	     requested visType_ and visComp_, and includes the requested
@@ -2610,29 +2651,16 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		computeVisShape_(visShape_, visShapeA_);
 
-		Int vnTime=visShape_[TIME], vnBsln=visShape_[BASELN],
-		    vnBslnA=visShapeA_[BASELN],
+		Int vnTime=visShape_[TIME], vnBslnA=visShapeA_[BASELN],
 		    vnChan=visShape_[CHAN], vnPol=visShape_[POL], vnSpw=visShape_[SP_W];
 
 
-		// For progress feedback.
-
-		Timer tmr;
-		Double pctDone = 100./max( 1.,  Double(mssel_->nrow()) *
-		                           Double(visShape_[SP_W]) /
-		                           max(1., Double(msShape_[SP_W])) );
-		// chunks not in sp.win. range won't need to be read.
-		// Inaccurate progress values may still result, however,
-		// when the various sp.wins have uneven amounts of data...
-		Bool prgShown=false;
-		Int iRow=0, iIter=0, iChunk=0;
-		Double intvl=3.;
-
+		waitForExtract_(false);		// (vis_ and flags_ are about to go).
 
 		vis_.resize(IPosition(5,   vnTime, vnBslnA, vnChan, vnPol, vnSpw));
 		vis_ = NO_DATA;	// (A value unused by real data).
 
-		Double visSize = vnTime*vnBslnA*vnChan*vnPol*vnSpw;
+		Double visSize = Double(vnTime)*vnBslnA*vnChan*vnPol*vnSpw;
 		static const Int uIntBits = sizeof(uInt)*8;
 		uInt flagsSize = uInt(ceil(visSize/uIntBits));
 		flags_.resize(flagsSize);	// a bit for every element of vis_...
@@ -2665,6 +2693,72 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// interval to load along the Z axis).  visShape_[axZ] (the size
 		// of the interval) was already set above, in computeVisShape_().
 
+
+		visValid_=false;		// (until loadVis_ has filled vis_).
+		loadVisType_=visType_;		// (what it is filled with).
+		loadVisComp_=visComp_;
+
+		if(backgroundExtract_) {
+			extractDone_ = false;
+			extractErr_ = "";
+			extracting_ = true;
+			purgeCache();		// (the old drawings go with the old vis_).
+			extractThread_ = std::thread(&MSAsRaster::loadVis_, this);
+			return;
+		}
+
+		loadVis_();
+		finishExtract_();
+	}
+
+
+//--------------------------------------------------------------------------
+	void MSAsRaster::loadVis_() {
+		// Runs fillVis_ (on the extraction thread in background mode),
+		// passing any error on to finishExtract_ in extractErr_.
+
+		try {
+			fillVis_();
+		} catch (const AipsError& x) {
+			extractErr_ = x.getMesg();
+		} catch (const std::exception& x) {
+			extractErr_ = x.what();
+		}
+
+		extractDone_ = true;
+	}
+
+
+//--------------------------------------------------------------------------
+	void MSAsRaster::fillVis_() {
+		// Iterate through the MS, filling vis_ and flags_ (already sized and
+		// positioned by extract_) and accumulating the data ranges.  While
+		// extracting_ is set, the GUI thread does not touch the MS selection,
+		// vis_, flags_ or the data ranges.  An abandoned extraction
+		// (extractCancel_) stops at the next chunk, leaving vis_ partly filled.
+
+		Int vnTime=visShape_[TIME], vnBsln=visShape_[BASELN],
+		    vnBslnA=visShapeA_[BASELN],
+		    vnChan=visShape_[CHAN], vnPol=visShape_[POL], vnSpw=visShape_[SP_W];
+		static const Int uIntBits = sizeof(uInt)*8;
+
+
+		// For progress feedback--on the GUI thread only: none is written
+		// from the extraction thread.
+
+		Bool showPrg = !backgroundExtract_;
+		Timer tmr;
+		Double pctDone = 100./max( 1.,  Double(mssel_->nrow()) *
+		                           Double(visShape_[SP_W]) /
+		                           max(1., Double(msShape_[SP_W])) );
+		// chunks not in sp.win. range won't need to be read.
+		// Inaccurate progress values may still result, however,
+		// when the various sp.wins have uneven amounts of data...
+		Bool prgShown=false;
+		Int iRow=0, iIter=0, iChunk=0;
+		Double intvl=3.;
+
+
 		Int vsTime=visStart_[TIME], vsBsln=visStart_[BASELN],
 		    vsChan=visStart_[CHAN], vsPol=visStart_[POL], vsSpw=visStart_[SP_W];
 
@@ -2680,8 +2774,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// completely (as opposed to just allowing them to expand).
 
 		static const Float radToDeg = 180.f / 3.14159265f;
-		Bool resid = (visType_ >= RESIDUAL),
-		     phase = (visComp_ == PHASE);
+		Bool resid = (loadVisType_ >= RESIDUAL),
+		     phase = (loadVisComp_ == PHASE);
 
 		if(phase) {
 			dataRngMin_=-180.;
@@ -2703,7 +2797,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		                         };
 		// compFn contains pointers to the standard library
 		// complex-to-float conversion routine, corresponding to visComp_.
-		CompFn& component = *(compFn[visComp_]);
+		CompFn& component = *(compFn[loadVisComp_]);
 		// component(complexVisibility)  will return the correct
 		// real component of complexVisibility, when used below.
 
@@ -2711,7 +2805,15 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		String polerr = "MSAsRaster: polarization conformance error in MS";
 
 
-		IPosition slot(NAXES);  // index into vis_ array
+		// vis_ is filled directly through its storage; the offsets below
+		// are hand-computed from the 5 axis values, as for flags_.  Time
+		// is the fastest-varying axis of vis_.
+		Bool delVis;
+		Float* visStor = vis_.getStorage(delVis);
+		size_t vChanStride = size_t(vnTime)*vnBslnA,
+		       vPolStride = vChanStride*vnChan,
+		       vSpwStride = vPolStride*vnPol;
+		size_t vsOffset = 0;	// offset of the current sp. win. in vis_.
 
 		Cube<Complex> vc, vc0;
 		Cube<Bool> flg;
@@ -2724,7 +2826,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		VisibilityIterator &vi(*wvi_p);
 		VisBuffer vb(vi);
 
-		for (vi.originChunks(); vi.moreChunks(); vi.nextChunk()) {
+		for (vi.originChunks(); vi.moreChunks() && !extractCancel_; vi.nextChunk()) {
 
 			Int iRowChunk=iRow;		// # rows processed prior to this chunk
 			Bool doneChunk=false;	// signals that we're finished (early)
@@ -2732,7 +2834,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 			Int spw = spw_(vi.spectralWindow());	  // Sp. Win. axis index.
 			if(spw<vsSpw || spw>=veSpw) doneChunk=true;   // not in spw range of vis_.
-			else slot(SP_W)=spw-vsSpw;
+			else vsOffset = vSpwStride*(spw-vsSpw);
 
 			Int polId = vi.polarizationId();
 			if(polId<0 || polId>=nPolIds_) throw AipsError(polerr);
@@ -2784,11 +2886,11 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 			Int iTime = vsTime;
 			Double searchTime = time_[iTime];
-			Int tsOffset=0;
+			size_t tsOffset=0;
 			Bool newTime=true;
 
 
-			for (vi.origin(); vi.more(); vi++) {
+			for (vi.origin(); vi.more() && !extractCancel_; vi++) {
 
 				Int nRow=vb.nRow();
 
@@ -2804,18 +2906,25 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 				}
 				// need both corrected and model vis cubes for residual.
 				else
-					vi.visibility(vc, (VisibilityIterator::DataColumn)visType_);
+					vi.visibility(vc, (VisibilityIterator::DataColumn)loadVisType_);
 				// Only single cube of correct type needed.
 
 				vi.flag(flg);	// Retrieve corresponding flags.
 				vi.flagRow(flgRow);
 
+				// Storage of the cubes, indexed [pol + nVcPol*(chn + nVcChan*row)].
+				Int nVcPol=vc.shape()(0), nVcChan=vc.shape()(1);
+				Bool delVc, delVc0=false, delFlg;
+				const Complex* vcStor = vc.getStorage(delVc);
+				const Complex* vc0Stor = resid? vc0.getStorage(delVc0) : 0;
+				const Bool* flgStor = flg.getStorage(delFlg);
+
 
 				// Transfer the data to vis_ and flags_ arrays.
 
 				for (Int row=0; row<nRow; row++) {
 
-					if(tmr.real()>intvl) {
+					if(showPrg && tmr.real()>intvl) {
 						if(!prgShown) {
 							cerr<<endl<<"Loading MS vis. data:  "<<flush;
 							prgShown=true;
@@ -2845,7 +2954,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 					// time found in time_ vector at slot iTime.
 
-					slot(TIME)=iTime-vsTime;
+					size_t tOffset = vsOffset + (iTime-vsTime);
 
 					// For reasons of efficiency, the offset into the 1-D flags_
 					// vector is hand-computed in the loops below, given the 5 axis
@@ -2853,7 +2962,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 					// 'bit'.  The same array index arithmetic appears in a compact
 					// form in setFlag_(slot), which could have been used instead.
 					if(newTime) {
-						tsOffset = vnBslnA*(vnSpw*(iTime-vsTime) + spw-vsSpw);
+						tsOffset = size_t(vnBslnA)*(size_t(vnSpw)*(iTime-vsTime) + spw-vsSpw);
 						newTime=false;
 					}
 
@@ -2875,29 +2984,31 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 					if(bsl<vsBsln || bsl>=veBsln) continue;  // not in Baseline range.
 
-					slot(BASELN)=bsl-vsBsln;
-					Int bOffset = vnPol*(tsOffset + bsl-vsBsln);
+					size_t bOffset = vnPol*(tsOffset + (bsl-vsBsln));
+					size_t bvOffset = tOffset + size_t(vnTime)*(bsl-vsBsln);
+					Bool rowFlagged = flgRow(row);
 
 
 					for (Int pol=frstPol; pol<lstPol; pol++) {
-						slot(POL)=pol-vsPol;
-						Int pOffset = vnChan*(bOffset + pol-vsPol);
+						size_t pOffset = vnChan*(bOffset + (pol-vsPol));
 						Int vcpol = pol-pidBase;
+						Float* visp = visStor + bvOffset + vPolStride*(pol-vsPol);
+						Int vcOffset = vcpol + nVcPol*nVcChan*row;
 						for (Int chn=frstChan; chn<lstChan; chn++) {
-							slot(CHAN)=chn-vsChan;
+							Int vci = vcOffset + nVcPol*chn;
 
 							Float v  =  (resid)?
-							            component( vc(vcpol,chn,row) - vc0(vcpol,chn,row) ) :
-							            component( vc(vcpol,chn,row) );
+							            component( vcStor[vci] - vc0Stor[vci] ) :
+							            component( vcStor[vci] );
 
 							if(phase) v *= radToDeg;		// show phases in degrees.
 
-							vis_(slot) = v;			// store visibility.
+							visp[vChanStride*(chn-vsChan)] = v;	// store visibility.
 
-							if(flgRow(row) || flg(vcpol,chn,row)) {	// store flags
-								Int offset = pOffset + chn-vsChan;
-								Int fslot = offset / uIntBits;
-								Int bit = offset % uIntBits;
+							if(rowFlagged || flgStor[vci]) {	// store flags
+								size_t offset = pOffset + (chn-vsChan);
+								size_t fslot = offset / uIntBits;
+								uInt bit = offset % uIntBits;
 								flags_(fslot) = flags_(fslot) | 1u<<bit;
 							}
 
@@ -2914,6 +3025,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 				}
 
 
+				vc.freeStorage(vcStor, delVc);
+				if(resid) vc0.freeStorage(vc0Stor, delVc0);
+				flg.freeStorage(flgStor, delFlg);
+
 				iIter++;
 				if(doneChunk) break;	// (from vi minor iterations).
 				iRow+=nRow;
@@ -2924,11 +3039,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		}		// for(vi Chunk iterations)
 
 
-		mssel_->relinquishAutoLocks(true);	 	// (just to be sure).
+		vis_.putStorage(visStor, delVis);
 
-		visValid_=true;		// validate vis_, and set its current
-		curVisType_=visType_;		// type and component to reflect the extract_
-		curVisComp_=visComp_;		// just completed according to user input.
+		mssel_->relinquishAutoLocks(true);	 	// (just to be sure).
 
 		// Clip data color scaling ranges to 3-sigma limits, so that wild
 		// data doesn't cause ridiculously large ranges on the sliders.
@@ -2943,6 +3056,28 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		}
 
 
+		if(prgShown) cerr<<"Done."<<endl<<endl;	// progress feedback.
+	}
+
+
+//--------------------------------------------------------------------------
+	void MSAsRaster::finishExtract_() {
+		// Completes extract_ on the GUI thread, once loadVis_ is done:
+		// validates vis_ and computes the derived data.
+
+		extracting_ = false;
+		if(!extractErr_.empty()) {
+			String err = extractErr_;
+			extractErr_ = "";
+			vis_.resize();
+			flags_.resize(0);
+			throw AipsError("MSAsRaster: error loading visibilities: " + err);
+		}
+
+		visValid_=true;		// validate vis_, and set its current
+		curVisType_=loadVisType_;	// type and component to reflect the extract_
+		curVisComp_=loadVisComp_;	// just completed according to user input.
+
 		// For visibility deviation displays.  (The range gathering is
 		// similar, but separate from the above).
 
@@ -2955,8 +3090,6 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// little time, and might not be necessary).
 
 
-		if(prgShown) cerr<<"Done."<<endl<<endl;	// progress feedback.
-
 		if(visDataChg_) {
 			resetMinMax_();	// Set newly-computed data range onto the DParams.
 			postDataRng_=true;
@@ -2971,6 +3104,37 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 	// data in memory, to avoid confusion.
 
 
+//--------------------------------------------------------------------------
+	void MSAsRaster::waitForExtract_(Bool finish) {
+		// Join the extraction thread, if running, and complete the
+		// extraction on this (GUI) thread, or abandon it if !finish.
+		// An abandoned extraction stops at its next chunk of the MS.
+
+		if(!extractThread_.joinable()) return;
+		if(!finish) extractCancel_ = true;
+		extractThread_.join();
+		extractCancel_ = false;
+		if(finish) finishExtract_();
+		else {
+			extracting_ = false;
+			extractErr_ = "";
+		}
+	}
+
+
+//--------------------------------------------------------------------------
+	Bool MSAsRaster::finishExtraction() {
+		// Polled by the viewer (on the GUI thread) while extracting():
+		// completes a background extraction once the thread has finished.
+		// Returns true if it did; setOptions() should then be called to
+		// post the new data ranges, and the display refreshed.
+
+		if(!extracting_ || !extractDone_) return false;
+		waitForExtract_();
+		return true;
+	}
+
+
 //--------------------------------------------------------------------------
 	void MSAsRaster::createDisplaySlice_() {
 		// create (2D) slice Matrices to draw on the WC, from vis_ and flags.
@@ -3258,6 +3422,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		conformsTo(wc);
 		if(!rstrsConformed_ || !csConformed_) return false;
 		if(!msselValid_) return false;	// No data--don't attempt to flag.
+		if(extracting_) return false;	// vis_ and flags_ are being loaded.
 
 		Int ix0 = max( 0, ifloor(blc_x+.5) );
 		Int ix1 = min( msShape_[axisOn_[X]], ifloor(trc_x+.5)+1 );
@@ -3277,6 +3442,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		ActiveCaching2dDD::handleEvent(ev);	// Give base class[es] a chance
 		// to handle the event too.
 
+		if(extracting_) return;	// No flagging while vis_ is being loaded.
 
 
 		CrosshairEvent* chev = dynamic_cast<CrosshairEvent*>(&ev);
@@ -4391,6 +4557,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		if(!msselValid_) return "";	// no data (disabled).
 
+		if(extracting_) return "";	// vis_ is still being loaded.
+
 		if(!rstrsConformed_ || !csConformed_) return "";
 		// Doesn't match wch restrictions or CS state.  Probably means
 		// this DD isn't the one in charge of the canvas (csMaster).
@@ -4603,6 +4771,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		if(!msselValid_) return "MS selection contains no data.\n"
 			                        "Change MS selections and press 'Apply'.\n\n";
 
+		if(extracting_) return "Loading visibility data...\n\n\n";
+
 		if(!rstrsConformed_ || !csConformed_) return "\n\n\n";
 		// Doesn't match wch restrictions or CS state.  Probably means
 		// this DD isn't the one in charge of the canvas (csMaster).
@@ -4772,6 +4942,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		if(!msselValid_) return false;
 
+		if(extracting_) return false;
+
 		if(!rstrsConformed_ || !csConformed_) return false;
 		// Doesn't match wch restrictions or CS state.  Probably means
 		// this DD isn't the one in charge of the canvas (csMaster).
@@ -5350,7 +5522,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 
 	Bool MSAsRaster::flag_(IPosition& slot) {
-		Int offset = (((	      slot(TIME)
+		size_t offset = ((((size_t)slot(TIME)
 		                          * visShape_[SP_W]   + slot(SP_W))
 		               * visShapeA_[BASELN] + slot(BASELN))
 		              * visShape_[POL]    + slot(POL))
@@ -5362,8 +5534,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// extract_ loop nesting, for efficiency there.
 
 		static const Int uIntBits = sizeof(uInt)*8;
-		Int indx = offset / uIntBits;
-		Int bit = offset % uIntBits;
+		size_t indx = offset / uIntBits;
+		uInt bit = offset % uIntBits;
 
 		return ( (flags_(indx) & 1u<<bit) != 0 );
 	}
@@ -5374,15 +5546,15 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// This routine writes data into flags_, an internal array
 		// corresponding to the current state of flags in the MS, but it
 		// does not itself write any flags to disk.
-		Int offset = (((	      slot(TIME)
+		size_t offset = ((((size_t)slot(TIME)
 		                          * visShape_[SP_W]   + slot(SP_W))
 		               * visShapeA_[BASELN] + slot(BASELN))
 		              * visShape_[POL]    + slot(POL))
 		             * visShape_[CHAN]   + slot(CHAN);
 
 		static const Int uIntBits = sizeof(uInt)*8;
-		Int indx = offset / uIntBits;
-		Int bit = offset % uIntBits;
+		size_t indx = offset / uIntBits;
+		uInt bit = offset % uIntBits;
 
 		if(flag) flags_(indx) |=   1u<<bit;		// Set flag
 		else     flags_(indx) &= ~(1u<<bit);
@@ -5969,6 +6141,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 
 	MSAsRaster::~MSAsRaster() {
+		waitForExtract_(false);			// (the extraction thread uses this object).
 		removeFromAllWCHs();			// disconnect from canvases/refresh events.
 
 		if(msValid_)
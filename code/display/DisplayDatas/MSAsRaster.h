@@ -50,6 +50,8 @@
 #include <display/DisplayDatas/DisplayDataOptions.h>
 #include <display/Display/Colormap.h>
 #include <display/region/Region.qo.h>
+#include <atomic>
+#include <thread>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -296,6 +298,21 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// added to allow flagging control from mouse tools... <drs>
 		bool flag( WorldCanvas *wc, double blc_x, double blc_y, double trc_x, double trc_y );
 
+		// Visibilities are loaded on a separate thread, unless the aipsrc
+		// variable display.msasraster.background is false.  While loading,
+		// extracting() is true and the DD neither draws nor flags; the viewer
+		// should poll finishExtraction() (on the GUI thread), which completes
+		// the load once the thread is done and returns true.  setOptions()
+		// should then be called (to post the new data ranges) and the
+		// display refreshed.  setOptions() does not wait for a running
+		// load; it abandons it only when the data to load change.
+		// <group>
+		casacore::Bool extracting() const {
+			return extracting_;
+		}
+		casacore::Bool finishExtraction();
+		// </group>
+
 		std::string errorMessage( ) const { return ""; }
 
 	protected:
@@ -384,7 +401,19 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 		// Extract the hypercube buffer of visibilities for the requested
 		// casacore::MS selection and axis settings (the most time-consuming operation).
+		// In background mode, extract_ only sets vis_ up and starts loadVis_ on
+		// the extraction thread; finishExtract_ completes it on the GUI thread.
+		// <group>
 		void extract_();
+		void loadVis_();
+		void fillVis_();
+		void finishExtract_();
+		// </group>
+
+		// Join a running extraction thread, and complete the extraction
+		// (or, if finish is false, abandon it: the thread is told to stop
+		// at its next chunk of the MS).
+		void waitForExtract_(casacore::Bool finish=true);
 
 		// retrieve (2D) slice data casacore::Matrix, and corresponding mask/flag
 		// matrices, to send to the display canvas.
@@ -979,6 +1008,15 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// When true, setOptions will return these new
 		// ranges unaltered to the gui, via recOut.
 
+		casacore::Bool backgroundExtract_;	// Load vis_ on extractThread_.
+		std::thread extractThread_;
+		std::atomic<bool> extracting_;	// vis_ is being loaded on extractThread_.
+		std::atomic<bool> extractDone_;	// extractThread_ has finished.
+		std::atomic<bool> extractCancel_;	// Asks extractThread_ to stop reading.
+		VisType loadVisType_;	// The visType_ and visComp_ being loaded
+		VisComp loadVisComp_;	// on extractThread_ (fillVis_ reads these).
+		casacore::String extractErr_;	// Error from the extraction thread.
+
 
 		//----translation between casacore::MS values and internal hypercube indices---------
 
@@ -298,6 +298,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 			}
 			else if( isMS() && isRaster() ) {
 				dd_ = new MSAsRaster( path_, ddo );
+				QTimer::singleShot(200, this, SLOT(checkMSExtraction_()));
 			} else if(dataType_==TYPE_IMAGE || dataType_=="lel") {
 
 				if(dataType_==TYPE_IMAGE) {
@@ -1001,6 +1002,30 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 
 
+	void QtDisplayData::checkMSExtraction_() {
+		MSAsRaster* msar = dynamic_cast<MSAsRaster*>(dd_);
+		if(msar==0 || !msar->extracting()) return;
+
+		try {
+			if(!msar->finishExtraction()) {
+				// Still loading: look again later.
+				QTimer::singleShot(200, this, SLOT(checkMSExtraction_()));
+				return;
+			}
+		} catch (const casacore::AipsError& err) {
+			errMsg_ = err.getMesg();
+			emit qddError(errMsg_);
+			return;
+		}
+
+		// Post the data ranges computed by the load to the options gui,
+		// and draw the new data.
+		setOptions(Record(), true);
+		dd_->refresh(true);
+	}
+
+
+
 	void QtDisplayData::setOptions(Record opts, Bool emitAll) {
 		// Apply option values to the DisplayData.  Method will
 		// emit optionsChanged() if other option values, limits, etc.
@@ -1084,6 +1109,12 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 				dd_->refresh(true);
 			}
 
+			// An MSAsRaster may have started loading new visibilities.
+			MSAsRaster* msar = dynamic_cast<MSAsRaster*>(dd_);
+			if(msar!=0 && msar->extracting()) {
+				QTimer::singleShot(200, this, SLOT(checkMSExtraction_()));
+			}
+
 			held=false;
 			panel_->viewer()->release();
 			if(cbNeedsRefresh) {
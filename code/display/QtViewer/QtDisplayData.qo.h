@@ -404,6 +404,11 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 		// also called during initialization.
 		virtual void setColorBarOrientation_();
 
+		// Polls an MSAsRaster dd_ whose visibilities are being loaded on a
+		// separate thread; once they are in, posts its new options (data
+		// ranges) and redraws it.
+		virtual void checkMSExtraction_();
+
 
 	protected:
 
@@ -208,21 +208,20 @@ FlagAgentClipping::computeInRowFlags(const vi::VisBuffer2 &/*visBuffer*/, VisMap
 		FlagMapper &flags, uInt row)
 {
 	// Get flag cube size
-	Float visExpression;
 	Int nPols,nChannels,nTimesteps;
 	visibilities.shape(nPols, nChannels, nTimesteps);
 
-	for (uInt chan_i=0;chan_i<(uInt) nChannels;chan_i++)
+	// Evaluate the whole row at once and apply the resulting flags in bulk
+	visExpressions_p.resize(nChannels,1,false);
+	clipMask_p.resize(nChannels,1,false);
+	for (uInt pol_i=0;pol_i<(uInt) nPols;pol_i++)
 	{
-		for (uInt pol_i=0;pol_i<(uInt) nPols;pol_i++)
+		visibilities.evaluate(pol_i,row,visExpressions_p);
+		for (uInt chan_i=0;chan_i<(uInt) nChannels;chan_i++)
 		{
-			visExpression = visibilities(pol_i,chan_i,row);
-			if ((*this.*checkVis_p)(visExpression))
-			{
-				flags.applyFlag(pol_i,chan_i,row);
-				visBufferFlags_p += 1;
-			}
+			clipMask_p(chan_i,0) = (*this.*checkVis_p)(visExpressions_p(chan_i,0));
 		}
+		visBufferFlags_p += flags.applyFlags(pol_i,row,clipMask_p);
 	}
 
 	return false;
@@ -70,6 +70,10 @@ private:
 	// Specialization for the clipping case
 	bool (casa::FlagAgentClipping::*checkVis_p)(casacore::Float);
 
+	// Buffers for the evaluation of a row
+	casacore::Matrix<casacore::Float> visExpressions_p;
+	casacore::Matrix<casacore::Bool> clipMask_p;
+
 };
 
 
@@ -57,6 +57,7 @@ FlagAgentShadow::FlagAgentShadow(FlagDataHandler *dh, Record config, Bool writeP
 
 	// Set timekeeper to zero - this will later detect when the timestep changes.
 	currTime_p=0.0;
+	maxShadowCacheSize_p = 100000;
 
 	// Append the supplied additional antennas to COPIES of existing base-class lists.
 
@@ -288,10 +289,6 @@ void FlagAgentShadow::calculateShadowedAntennas(const vi::VisBuffer2 &visBuffer,
 	Double u,v,w, uvDistance;
 	Int nAnt = shadowAntennaDiameters_p.nelements();
 
-	// Init the list of baselines, to later decide which to read and which to recalculate.
-	Vector<Bool> listBaselines(nAnt*(nAnt-1)/2);
-	listBaselines = false;
-
 	/*
 	///
 	/// Commenting out this section, to force recalculation of UVWs for all baselines
@@ -343,28 +340,50 @@ void FlagAgentShadow::calculateShadowedAntennas(const vi::VisBuffer2 &visBuffer,
 	 */
 
 
-	// (2) Now, if there are any untouched baselines, calculate 'uvw' for all antennas,
-	//      and fill in missing baselines.
+	// (2) Now calculate 'uvw' for all antennas, and from there check all baselines.
 	// This is the part that picks up invisible antennas, whether they come from the antenna_subtable or
 	// are externally supplied.
-	if(product(listBaselines)==false)
+	// The antennas are projected onto the uv plane (perpendicular to the source direction) and binned
+	// into a uniform grid whose cells are as large as the largest shadowing distance. Only the pairs of
+	// antennas in the same or in neighbouring cells can shadow each other, so the cost is linear in the
+	// number of antennas instead of quadratic.
+	if (nAnt < 2) return;
+
+	Double maxShadowDistance = max(shadowAntennaDiameters_p) - shadowTolerance_p;
+	if (maxShadowDistance <= 0) return;
+
+	// For the current timestep, compute UVWs for all antennas.
+	//    uvwAnt_p will be filled these values.
+	computeAntUVW(visBuffer, rownr);
+
+	std::map< std::pair<Int,Int>, vector<Int> > uvGrid;
+	vector< std::pair<Int,Int> > antennaCell(nAnt);
+	for (Int antenna=0; antenna<nAnt; antenna++)
 	{
-		// For the current timestep, compute UVWs for all antennas.
-		//    uvwAnt_p will be filled these values.
-		computeAntUVW(visBuffer, rownr);
+		antennaCell[antenna] = std::make_pair((Int)floor(uvwAnt_p(0,antenna)/maxShadowDistance),
+											  (Int)floor(uvwAnt_p(1,antenna)/maxShadowDistance));
+		uvGrid[antennaCell[antenna]].push_back(antenna);
+	}
 
-		// For all untouched baselines, calculate uvw and check for shadows.
-		for (Int antenna1=0; antenna1<nAnt; antenna1++)
+	// For all baselines between neighbouring antennas, calculate uvw and check for shadows.
+	for (Int antenna1=0; antenna1<nAnt; antenna1++)
+	{
+		Double u1=uvwAnt_p(0,antenna1), v1=uvwAnt_p(1,antenna1), w1=uvwAnt_p(2,antenna1);
+		for (Int du=-1; du<=1; du++)
 		{
-			Double u1=uvwAnt_p(0,antenna1), v1=uvwAnt_p(1,antenna1), w1=uvwAnt_p(2,antenna1);
-			for (Int antenna2=antenna1; antenna2<nAnt; antenna2++)
+			for (Int dv=-1; dv<=1; dv++)
 			{
-				// Check if this row corresponds to autocorrelation (Antennas don't shadow themselves)
-				if (antenna1 == antenna2) continue;
+				std::map< std::pair<Int,Int>, vector<Int> >::const_iterator cell;
+				cell = uvGrid.find(std::make_pair(antennaCell[antenna1].first+du,antennaCell[antenna1].second+dv));
+				if (cell == uvGrid.end()) continue;
 
-				// Proceed only if we don't already have this.
-				if(listBaselines[baselineIndex(nAnt,antenna1,antenna2)] == false)
+				for (vector<Int>::const_iterator iter=cell->second.begin(); iter!=cell->second.end(); iter++)
 				{
+					// Each baseline is checked once, as (antenna1,antenna2) with antenna1<antenna2
+					// (Antennas don't shadow themselves)
+					Int antenna2 = *iter;
+					if (antenna2 <= antenna1) continue;
+
 					Double u2=uvwAnt_p(0,antenna2), v2=uvwAnt_p(1,antenna2), w2=uvwAnt_p(2,antenna2);
 
 					u = u2-u1;
@@ -523,7 +542,26 @@ FlagAgentShadow::computeRowFlags(const vi::VisBuffer2 &visBuffer, FlagMapper &/*
 	if( currTime_p != visBuffer.timeCentroid()(row) )
 	{
 		currTime_p = visBuffer.timeCentroid()(row) ;
-		calculateShadowedAntennas(visBuffer, row);
+
+		// The shadowed antennas only depend on the timestep and on the phase center, so the
+		// result is kept to be re-used by the other buffers (e.g. spws) of the same timestep.
+		vector<Double> key(4);
+		key[0] = currTime_p;
+		key[1] = visBuffer.phaseCenter().getValue().get()[0];
+		key[2] = visBuffer.phaseCenter().getValue().get()[1];
+		key[3] = visBuffer.phaseCenter().getRef().getType();
+
+		std::map< vector<Double>, vector<Int> >::const_iterator cached = shadowCache_p.find(key);
+		if (cached != shadowCache_p.end())
+		{
+			shadowedAntennas_p = cached->second;
+		}
+		else
+		{
+			calculateShadowedAntennas(visBuffer, row);
+			if (shadowCache_p.size() >= maxShadowCacheSize_p) shadowCache_p.clear();
+			shadowCache_p[key] = shadowedAntennas_p;
+		}
 	}
 
 	bool flagRow = false;
@@ -100,6 +100,10 @@ private:
         casacore::Matrix<casacore::Double> uvwAnt_p;
         casacore::Double currTime_p;
 
+        // Shadowed antennas already computed, per (timestep, phase center)
+        std::map< vector<casacore::Double>, vector<casacore::Int> > shadowCache_p;
+        casacore::uInt maxShadowCacheSize_p;
+
         casacore::Bool firststep_p; // helper variable to control a debug print statement
     
 };
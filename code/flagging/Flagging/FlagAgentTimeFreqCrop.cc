@@ -233,6 +233,12 @@ FlagAgentTimeFreqCrop::computeAntennaPairFlags(const vi::VisBuffer2 & /*visBuffe
                                                Int /*antenna2*/,
                                                vector<uInt> & /*rows*/)
 {
+	// Evaluate the visibility expression once for the whole (freq,time) plane,
+	// both directions below work on this plane.
+	IPosition flagCubeShape = visibilities.shape();
+	visPlane_p.resize(flagCubeShape(0),flagCubeShape(1));
+	visibilities.evaluate(0,0,visPlane_p);
+
 	// Call 'fltBaseAndFlag' as specified by the user.
 	if(flagDimension_p == String("time"))
 	  {
@@ -269,9 +275,9 @@ void FlagAgentTimeFreqCrop :: fitBaseAndFlag(String fittype, String direction, V
   uInt nChannels = flagCubeShape(0);
   uInt nTimes = flagCubeShape(1);
 
-  // Work variables
-  Vector<Float> avgDat,avgFit;
-  Vector<Bool> avgFlag;
+  // Work variables (the averages are members, reused from one baseline to the next)
+  Vector<Float> &avgDat = avgDat_p, &avgFit = avgFit_p;
+  Vector<Bool> &avgFlag = avgFlag_p;
   Vector<Int> mind(2);
   Float tol=4.0,mn=1.0,sd=0,tpsd=0.0,tpsum=0.0, mval=0.0;
   Int mcnt=0;
@@ -292,11 +298,28 @@ void FlagAgentTimeFreqCrop :: fitBaseAndFlag(String fittype, String direction, V
       throw AipsError("Internal Error. Unrecognized axis direction for tfcrop : " + direction);
     }
   
-  // ALLOC : Resize temp arrays to either nChannel or nTime
+  // ALLOC : Resize temp arrays to either nChannel or nTime (no-op if already the right size)
   avgDat.resize(mind[0]);   avgDat=0.0;   
   avgFit.resize(mind[0]);    avgFit=0.0;                
   avgFlag.resize(mind[0]);  avgFlag=false;
 
+  // Read the flags of the whole (freq,time) plane once. The new flags are
+  // collected in flagMask_p and applied at the end, they only ever concern
+  // points that have already been read.
+  flagPlane_p.resize(nChannels,nTimes);
+  flagMask_p.resize(nChannels,nTimes);
+  flagMask_p = false;
+  for(uInt it=0;it<nTimes;it++)
+    {
+      for(uInt ic=0;ic<nChannels;ic++)
+	{
+	  flagPlane_p(ic,it) = flags.getModifiedFlags(ic,it);
+	}
+    }
+
+  Bool winSum = (winStats_p=="sum" || winStats_p=="both");
+  Bool winStd = (winStats_p=="std" || winStats_p=="both");
+
   // A way to tell if anything is non-zero in this piece.
   Bool allzeros=true; 
   
@@ -312,17 +335,17 @@ void FlagAgentTimeFreqCrop :: fitBaseAndFlag(String fittype, String direction, V
 	{
 	  if(mind[0]==(Int) nChannels)// if i0 is channel, and i1 is time
 	    {
-	      if( ! ( flags.getModifiedFlags(i0,i1) ) ) //C// && usePreFlags_p ) )
+	      if( ! ( flagPlane_p(i0,i1) ) ) //C// && usePreFlags_p ) )
 		{
-		  mval += visibilities(i0,i1);
+		  mval += visPlane_p(i0,i1);
 		  mcnt++;
 		}
 	    }
 	  else // if i1 is channel, and i0 is time
 	    {
-	      if( ! ( flags.getModifiedFlags(i1,i0) ) ) //C// && usePreFlags_p ) )
+	      if( ! ( flagPlane_p(i1,i0) ) ) //C// && usePreFlags_p ) )
 		{
-		  mval += visibilities(i1,i0);
+		  mval += visPlane_p(i1,i0);
 		  mcnt++;
 		}
 	    }
@@ -366,13 +389,13 @@ void FlagAgentTimeFreqCrop :: fitBaseAndFlag(String fittype, String direction, V
 	    {
 	      if(mind[0]==(Int) nChannels)// if i0 is channel, and i1 is time
 		{
-		  avgFlag[i0] = flags.getModifiedFlags(i0,i1); //C// && usePreFlags_p;
-		  if(avgFlag[i0]==false) avgDat[i0] = visibilities(i0,i1)/avgFit(i0);
+		  avgFlag[i0] = flagPlane_p(i0,i1); //C// && usePreFlags_p;
+		  if(avgFlag[i0]==false) avgDat[i0] = visPlane_p(i0,i1)/avgFit(i0);
 		}
 	      else // if i1 is channel, i0 is time
 		{
-		  avgFlag[i0] = flags.getModifiedFlags(i1,i0); //C// && usePreFlags_p;
-		  if(avgFlag[i0]==false) avgDat[i0] = visibilities(i1,i0)/avgFit(i0);
+		  avgFlag[i0] = flagPlane_p(i1,i0); //C// && usePreFlags_p;
+		  if(avgFlag[i0]==false) avgDat[i0] = visPlane_p(i1,i0)/avgFit(i0);
 		}
 	    }//for i0
 
@@ -408,14 +431,14 @@ void FlagAgentTimeFreqCrop :: fitBaseAndFlag(String fittype, String direction, V
 		  tpsum=0.0;tpsd=0.0;
 		  
 		  // Flag point i0  if average of N points around i0 crosses N sd
-		  if(winStats_p=="sum" || winStats_p=="both")
+		  if(winSum)
 		    {
 		      for(Int i=i0-halfWin_p; i<i0+halfWin_p+1; i++) tpsum += fabs(avgDat[i]-mn);
 		      if(tpsum/(2*halfWin_p+1.0) > tol*sd ) avgFlag[i0]=true;
 		    }
 		  
 		  // Flag point i0 if the N point std around i0 is larger then N sd
-		  if(winStats_p=="std" || winStats_p=="both")
+		  if(winStd)
 		    {
 		      for(Int i=i0-halfWin_p; i<i0+halfWin_p+1; i++) tpsd += (avgDat[i]-mn) * (avgDat[i]-mn) ;
 		      if(sqrt( tpsd / (2*halfWin_p+1.0) ) > tol*sd)  avgFlag[i0]=true ;
@@ -426,31 +449,26 @@ void FlagAgentTimeFreqCrop :: fitBaseAndFlag(String fittype, String direction, V
 
 
 	  // STEP 3D :
-	  // Fill the flags into the FlagMapper 
-	  // Note : To minimize copies, we can call flags.applyFlag() directly from STEPS 3B and 3C,
-	  //           in addition to filling in avgFlag for STEP 3B.  
-	  //       However, the following ensures minimal calls to flags.applyFlag().
+	  // Collect the flags for the FlagMapper
+	  // Note : The whole plane is applied at once (STEP 4), which ensures
+	  //        minimal calls into the FlagMapper.
 	  for(Int i0=0;i0<mind[0];i0++)
 	    {
 	      if(mind[0]==(Int) nChannels) // if i0 is channel, and i1 is time
 		{
-		  if(avgFlag[i0])
-		  {
-			  flags.applyFlag(i0,i1);
-			  visBufferFlags_p += 1;
-		  }
+		  if(avgFlag[i0]) flagMask_p(i0,i1) = true;
 		}
 	      else //if i1 is channel, and i0 is time
 		{
-		  if(avgFlag[i0])
-		  {
-			  flags.applyFlag(i1,i0);
-			  visBufferFlags_p += 1;
-		  }
+		  if(avgFlag[i0]) flagMask_p(i1,i0) = true;
 		}
 	    }// for i0
 	  
 	}//for i1
+
+      // STEP 4 :
+      // Fill the flags into the FlagMapper
+      visBufferFlags_p += flags.applyFlags(0,0,flagMask_p);
       
     }// if allzeros==false
 
@@ -562,9 +580,9 @@ void FlagAgentTimeFreqCrop :: fitPiecewisePoly(Vector<Float> &data, Vector<Bool>
   Int deg=0;//,start=0;
   Int left=0,right=0;
   Float sd,TOL=3;
-  Vector<Float> tdata;
+  Vector<Float> &tdata = tdata_p;
   
-  // ALLOC : Another temp array to hold modified data
+  // ALLOC : Another temp array to hold modified data (reused across calls)
   tdata.resize(data.nelements());
   tdata = data;
   
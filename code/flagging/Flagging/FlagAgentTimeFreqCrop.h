@@ -93,6 +93,17 @@ private:
   // Fit a line to a range of data points
   void lineFit(casacore::Vector<casacore::Float> &data,casacore::Vector<casacore::Bool> &flag, casacore::Vector<casacore::Float> &fit, casacore::uInt lim1, casacore::uInt lim2);
   
+  /////// TFCROP workspace, reused from one baseline to the next
+
+  // Evaluated visibilities, original flags and new flags of the (freq,time) plane
+  casacore::Matrix<casacore::Float> visPlane_p;
+  casacore::Matrix<casacore::Bool> flagPlane_p;
+  casacore::Matrix<casacore::Bool> flagMask_p;
+  // Averages along one direction, their fit, and the modified data of the fit
+  casacore::Vector<casacore::Float> avgDat_p;
+  casacore::Vector<casacore::Float> avgFit_p;
+  casacore::Vector<casacore::Bool> avgFlag_p;
+  casacore::Vector<casacore::Float> tdata_p;
 
 
 };
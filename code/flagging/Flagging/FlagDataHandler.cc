@@ -2209,6 +2209,151 @@ VisMapper::correlationProduct(uInt pol, uInt chan, uInt row)
 }
 
 
+void
+VisMapper::evaluate(uInt pol, uInt rowStart, Matrix<Float> &values)
+{
+	// Resolve the correlation product as a combination of (at most) two
+	// correlations, once for the whole block instead of once per sample
+	enum {SINGLE, HALF_SUM, HALF_DIFF, HALF_DIFF_I} combination = SINGLE;
+	Int corr1 = -1, corr2 = -1;
+	corrProduct product = selectedCorrelationProducts_p[pol];
+	if (product == &VisMapper::stokes_i) corr1 = Stokes::I;
+	else if (product == &VisMapper::stokes_q) corr1 = Stokes::Q;
+	else if (product == &VisMapper::stokes_u) corr1 = Stokes::U;
+	else if (product == &VisMapper::stokes_v) corr1 = Stokes::V;
+	else if (product == &VisMapper::linear_xx) corr1 = Stokes::XX;
+	else if (product == &VisMapper::linear_yy) corr1 = Stokes::YY;
+	else if (product == &VisMapper::linear_xy) corr1 = Stokes::XY;
+	else if (product == &VisMapper::linear_yx) corr1 = Stokes::YX;
+	else if (product == &VisMapper::circular_rr) corr1 = Stokes::RR;
+	else if (product == &VisMapper::circular_ll) corr1 = Stokes::LL;
+	else if (product == &VisMapper::circular_rl) corr1 = Stokes::RL;
+	else if (product == &VisMapper::circular_lr) corr1 = Stokes::LR;
+	else if (product == &VisMapper::calsol1) corr1 = VisMapper::CALSOL1;
+	else if (product == &VisMapper::calsol2) corr1 = VisMapper::CALSOL2;
+	else if (product == &VisMapper::calsol3) corr1 = VisMapper::CALSOL3;
+	else if (product == &VisMapper::calsol4) corr1 = VisMapper::CALSOL4;
+	else if (product == &VisMapper::stokes_i_from_linear)
+	{
+		corr1 = Stokes::XX; corr2 = Stokes::YY; combination = HALF_SUM;
+	}
+	else if (product == &VisMapper::stokes_q_from_linear)
+	{
+		corr1 = Stokes::XX; corr2 = Stokes::YY; combination = HALF_DIFF;
+	}
+	else if (product == &VisMapper::stokes_u_from_linear)
+	{
+		corr1 = Stokes::XY; corr2 = Stokes::YX; combination = HALF_DIFF;
+	}
+	else if (product == &VisMapper::stokes_v_from_linear)
+	{
+		corr1 = Stokes::XY; corr2 = Stokes::YX; combination = HALF_DIFF_I;
+	}
+	else if (product == &VisMapper::stokes_i_from_circular)
+	{
+		corr1 = Stokes::RR; corr2 = Stokes::LL; combination = HALF_SUM;
+	}
+	else if (product == &VisMapper::stokes_q_from_circular)
+	{
+		corr1 = Stokes::RL; corr2 = Stokes::LR; combination = HALF_DIFF;
+	}
+	else if (product == &VisMapper::stokes_u_from_circular)
+	{
+		corr1 = Stokes::RL; corr2 = Stokes::LR; combination = HALF_DIFF_I;
+	}
+	else if (product == &VisMapper::stokes_v_from_circular)
+	{
+		corr1 = Stokes::RR; corr2 = Stokes::LL; combination = HALF_DIFF_I;
+	}
+
+	uInt nChannels = values.nrow();
+	uInt nRows = values.ncolumn();
+
+	// Unknown correlation product: fall back to the sample by sample evaluation
+	if (corr1 < 0)
+	{
+		for (uInt row_i=0;row_i<nRows;row_i++)
+		{
+			for (uInt chan_i=0;chan_i<nChannels;chan_i++)
+			{
+				values(chan_i,row_i) = operator()(pol,chan_i,rowStart+row_i);
+			}
+		}
+		return;
+	}
+
+	corrPlane1_p.resize(nChannels,nRows,false);
+	visPlane((*polMap_p)[corr1],rowStart,corrPlane1_p);
+	if (corr2 >= 0)
+	{
+		using casacore::operator*;
+		const Complex twoI = 2*ImaginaryUnit;
+
+		corrPlane2_p.resize(nChannels,nRows,false);
+		visPlane((*polMap_p)[corr2],rowStart,corrPlane2_p);
+		for (uInt row_i=0;row_i<nRows;row_i++)
+		{
+			for (uInt chan_i=0;chan_i<nChannels;chan_i++)
+			{
+				Complex &val = corrPlane1_p(chan_i,row_i);
+				const Complex &val2 = corrPlane2_p(chan_i,row_i);
+				switch (combination)
+				{
+					case HALF_SUM: val = (val + val2)/2; break;
+					case HALF_DIFF: val = (val - val2)/2; break;
+					default: val = (val - val2)/twoI; break;
+				}
+			}
+		}
+	}
+
+	// Apply the complex unitary function with a tight loop per function
+	Bool deleteIn, deleteOut;
+	const Complex *in = corrPlane1_p.getStorage(deleteIn);
+	Float *out = values.getStorage(deleteOut);
+	size_t nValues = values.nelements();
+	if (applyVisExpr_p == &VisMapper::real)
+	{
+		for (size_t i=0;i<nValues;i++) out[i] = in[i].real();
+	}
+	else if (applyVisExpr_p == &VisMapper::imag)
+	{
+		for (size_t i=0;i<nValues;i++) out[i] = in[i].imag();
+	}
+	else if (applyVisExpr_p == &VisMapper::arg)
+	{
+		for (size_t i=0;i<nValues;i++) out[i] = std::arg(in[i]);
+	}
+	else if (applyVisExpr_p == &VisMapper::norm)
+	{
+		for (size_t i=0;i<nValues;i++) out[i] = std::norm(in[i]);
+	}
+	else
+	{
+		for (size_t i=0;i<nValues;i++) out[i] = std::abs(in[i]);
+	}
+	corrPlane1_p.freeStorage(in,deleteIn);
+	values.putStorage(out,deleteOut);
+
+	return;
+}
+
+
+void
+VisMapper::visPlane(uInt pol, uInt rowStart, Matrix<Complex> &plane)
+{
+	leftVis_p->plane(pol,rowStart,plane);
+	if (getVis_p == &VisMapper::diffVis)
+	{
+		rightPlane_p.resize(plane.shape(),false);
+		rightVis_p->plane(pol,rowStart,rightPlane_p);
+		plane -= rightPlane_p;
+	}
+
+	return;
+}
+
+
 Complex
 VisMapper::leftVis(uInt pol, uInt chan, uInt row)
 {
@@ -2663,6 +2808,29 @@ FlagMapper::applyFlag(uInt pol, uInt channel, uInt row)
 }
 
 
+uInt
+FlagMapper::applyFlags(uInt pol, uInt rowStart, const Matrix<Bool> &mask)
+{
+	uInt nFlagged = 0;
+	vector<uInt> &correlations = selectedCorrelations_p[pol];
+	for (uInt row_i=0;row_i<mask.ncolumn();row_i++)
+	{
+		for (uInt chan_i=0;chan_i<mask.nrow();chan_i++)
+		{
+			if (!mask(chan_i,row_i)) continue;
+
+			for (vector<uInt>::iterator iter=correlations.begin();iter!=correlations.end();iter++)
+			{
+				(*this.*applyFlag_p)(*iter,chan_i,rowStart+row_i);
+			}
+			nFlagged++;
+		}
+	}
+
+	return nFlagged;
+}
+
+
 void
 FlagMapper::applyFlagRow(uInt row)
 {
@@ -181,6 +181,34 @@ public:
     	return;
     }
 
+    // Copy the (i2,i3) plane of the view at i1 into values, starting at i3Start.
+    // The index mappings are resolved here instead of once per element.
+    void plane(casacore::uInt i1, casacore::uInt i3Start, casacore::Matrix<T> &values)
+    {
+    	casacore::uInt n2 = values.nrow();
+    	casacore::uInt n3 = values.ncolumn();
+    	casacore::uInt i1_index = (polarizations_p != NULL) ? polarizations_p->at(i1) : i1;
+    	for (casacore::uInt i3=0;i3<n3;i3++)
+    	{
+    		casacore::uInt i3_index = (rows_p != NULL) ? rows_p->at(i3Start+i3) : i3Start+i3;
+    		if (channels_p != NULL)
+    		{
+    			for (casacore::uInt i2=0;i2<n2;i2++)
+    			{
+    				values(i2,i3) = (*parentCube_p)(i1_index,(*channels_p)[i2],i3_index);
+    			}
+    		}
+    		else
+    		{
+    			for (casacore::uInt i2=0;i2<n2;i2++)
+    			{
+    				values(i2,i3) = (*parentCube_p)(i1_index,i2,i3_index);
+    			}
+    		}
+    	}
+    	return;
+    }
+
 protected:
 
     vector<casacore::uInt> *createIndex(casacore::uInt size)
@@ -362,6 +390,10 @@ public:
 	// Direct access to the complex correlation product
 	casacore::Complex correlationProduct(casacore::uInt pol, casacore::uInt chan, casacore::uInt row);
 
+	// Evaluate the expression of the selected correlation product pol for all the channels
+	// of the rows [rowStart,rowStart+values.ncolumn()). values is shaped [chan,row] by the caller.
+	void evaluate(casacore::uInt pol, casacore::uInt rowStart, casacore::Matrix<casacore::Float> &values);
+
     // NOTE: reducedLength_p is defined as [chan,row,pol]
     const casacore::IPosition &shape() const
     {
@@ -418,6 +450,9 @@ protected:
 	casacore::Complex calsol3(casacore::uInt chan, casacore::uInt row);
 	casacore::Complex calsol4(casacore::uInt chan, casacore::uInt row);
 
+	// Visibilities (or difference of visibilities) of a given polarization, as a [chan,row] plane
+	void visPlane(casacore::uInt pol, casacore::uInt rowStart, casacore::Matrix<casacore::Complex> &plane);
+
 
 private:
 	casacore::Float (casa::VisMapper::*applyVisExpr_p)(casacore::Complex);
@@ -431,6 +466,9 @@ private:
 	casacore::IPosition reducedLength_p;
 	polarizationMap *polMap_p;
 	casacore::String expression_p;
+	casacore::Matrix<casacore::Complex> corrPlane1_p;
+	casacore::Matrix<casacore::Complex> corrPlane2_p;
+	casacore::Matrix<casacore::Complex> rightPlane_p;
 };
 
 class FlagMapper
@@ -456,6 +494,10 @@ public:
 	void applyFlagRow(casacore::uInt row);
 	void applyFlagInRow(casacore::uInt row);
 
+	// Apply flags to the selected correlation product pol wherever mask, shaped [chan,row]
+	// from row rowStart, is set. Returns the number of (chan,row) points flagged.
+	casacore::uInt applyFlags(casacore::uInt pol, casacore::uInt rowStart, const casacore::Matrix<casacore::Bool> &mask);
+
 	casacore::Bool getOriginalFlags(casacore::uInt chan, casacore::uInt row);
 	casacore::Bool getModifiedFlags(casacore::uInt chan, casacore::uInt row);
 	casacore::Bool getPrivateFlags(casacore::uInt chan, casacore::uInt row);
@@ -30,6 +30,7 @@
 //# Includes
 
 #include <cmath>
+#include <vector>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
 #include <casa/fstream.h>
@@ -55,6 +56,7 @@
 #include <tables/DataMan/DataManError.h>
 
 #include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
 #include <casa/Arrays/MatrixMath.h>
 #include <casa/Arrays/ArrayError.h>
 #include <casa/Arrays/Matrix.h>
@@ -62,6 +64,7 @@
 #include <casa/Utilities/DataType.h>
 #include <casa/Quanta/MVTime.h>
 #include <casa/System/ProgressMeter.h>
+#include <casa/System/AipsrcValue.h>
 
 #include <casa/OS/RegularFile.h>
 #include <casa/OS/Directory.h>
@@ -79,6 +82,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 #define LOG0 0
 
 String FlagVersion::clname = "FlagVersion";
+String FlagVersion::deltarowcolname = "ROW_NUMBER";
+String FlagVersion::deltabasekeyword = "FLAG_VERSION_BASE";
 /* Constructor */
 FlagVersion::FlagVersion(String intab, String dataflagcolname, 
        String rowflagcolname)
@@ -128,6 +133,9 @@ FlagVersion::FlagVersion(String intab, String dataflagcolname,
         
    nrows_p = tab_p.nrow();
 
+   /* Save new versions as deltas against an earlier one if asked to */
+   AipsrcValue<Bool>::find (delta_p,"FlagVersion.delta", false);
+
    /* Make this a directory of flag tables */
    String flagdir(".flagversions");
    verlistfile_p = tabname_p + flagdir + String("/FLAG_VERSION_LIST");
@@ -211,6 +219,8 @@ Bool FlagVersion::attachFlagColumns(String version,
    
    if(exists && !version.matches("main"))
    {
+      /* The columns are attached to a full table */
+      expandFlagVersion(version);
       String tabvername = flagtablename_p + version;
       currentflagtable = Table(tabvername, Table::Update);
    }
@@ -230,7 +240,10 @@ Bool FlagVersion::attachFlagColumns(String version,
 }
 
 /*********************************************************************************/
-Bool FlagVersion::saveFlagsInto( Table &fromFTab, Table &toFTab, String merge )
+/* With a delta table, fromFTab is the base of the delta version and the rows
+   of the delta are patched into its flags as they are copied */
+Bool FlagVersion::saveFlagsInto( Table &fromFTab, Table &toFTab, String merge,
+                                 Table *delta )
 {
     String fnname= "saveFlagsInto";
 #if LOG0 
@@ -247,33 +260,34 @@ Bool FlagVersion::saveFlagsInto( Table &fromFTab, Table &toFTab, String merge )
         if( ! merge.matches("replace") &&
             ! merge.matches("and") &&
             ! merge.matches("or") ) merge = String("replace");
+
+   /* Rows of the delta version, in increasing order */
+   Vector<uInt> deltarows;
+   if(delta) deltarows = ScalarColumn<uInt>(*delta, deltarowcolname).getColumn();
         
    if(frcol_p)
    {
       ScalarColumn<Bool> fromRowFlag(fromFTab, rowflagcolname_p);
       ScalarColumn<Bool> toRowFlag(toFTab, rowflagcolname_p);
       
-      if( merge.matches("and") )
+      Vector<Bool> rfc = fromRowFlag.getColumn();
+      if(delta)
       {
-         Vector<Bool> rfc = fromRowFlag.getColumn();
-         rfc *= toRowFlag.getColumn();
-         toRowFlag.putColumn(rfc);
-      }
-      if( merge.matches("or") )
-      {
-         Vector<Bool> rfc = fromRowFlag.getColumn();
-         rfc += toRowFlag.getColumn();
-         toRowFlag.putColumn(rfc);
-      }
-      if( merge.matches("replace") ) {
-         toRowFlag.putColumn(fromRowFlag.getColumn());
+         ScalarColumn<Bool> deltaRowFlag(*delta, rowflagcolname_p);
+         for(uInt k=0;k<deltarows.nelements();k++)
+            rfc[deltarows[k]] = deltaRowFlag(k);
       }
+      if( merge.matches("and") ) rfc *= toRowFlag.getColumn();
+      if( merge.matches("or") ) rfc += toRowFlag.getColumn();
+      toRowFlag.putColumn(rfc);
    }
    
    if(fcol_p)
    {
       ArrayColumn<Bool> fromFlag(fromFTab, dataflagcolname_p);
       ArrayColumn<Bool> toFlag(toFTab, dataflagcolname_p);
+      ArrayColumn<Bool> deltaFlag;
+      if(delta) deltaFlag.attach(*delta, dataflagcolname_p);
 
       
       try { 
@@ -284,8 +298,13 @@ Bool FlagVersion::saveFlagsInto( Table &fromFTab, Table &toFTab, String merge )
 	   so we just need to process many rows at a time.
 	*/		
 	uInt chunk_rows = 100*1024*1024 / (shape(0) * shape(1)) + 1;
+	/* Keep the chunks aligned with the tiles of the flag version tables,
+	   so that each tile is written at once. */
+	uInt tile_rows = flagTileRows(shape(0), shape(1));
+	chunk_rows = ((chunk_rows + tile_rows - 1) / tile_rows) * tile_rows;
 	Array<Bool> arr1;
 	Array<Bool> arr2;
+	uInt k = 0;
 	for(unsigned i=0;i<nrows_p;i += chunk_rows)
 	  {
 	    unsigned j = i + chunk_rows - 1;
@@ -294,18 +313,23 @@ Bool FlagVersion::saveFlagsInto( Table &fromFTab, Table &toFTab, String merge )
 
 	    fromFlag.getColumnCells(arraySection,arr1,true);
 
+	    /* Patch the rows of the delta version into this chunk */
+	    for( ; k<deltarows.nelements() && deltarows[k]<=j; k++) {
+	      IPosition start(3, 0, 0, deltarows[k]-i);
+	      IPosition end(3, shape(0)-1, shape(1)-1, deltarows[k]-i);
+	      Array<Bool> cell(arr1(start,end).nonDegenerate(2));
+	      cell = deltaFlag(k);
+	    }
+
 	    if( merge.matches("and") ) {
 	      toFlag.getColumnCells(arraySection,arr2,true);
-	      arr2 *= arr1;
+	      arr1 *= arr2;
 	    }
 	    else if (merge.matches("or")) {
 	      toFlag.getColumnCells(arraySection,arr2,true);
-	      arr2 += arr1;
+	      arr1 += arr2;
 	    }
-	    else if (merge.matches("replace")) {
-	      arr2.assign(arr1);
-	    } 
-	    toFlag.putColumnCells(arraySection,arr2);
+	    toFlag.putColumnCells(arraySection,arr1);
 	  }
       }
       catch (DataManError &e)
@@ -324,26 +348,26 @@ Bool FlagVersion::saveFlagsInto( Table &fromFTab, Table &toFTab, String merge )
               // For now, go row by row....
               Array<Bool> arr1;
               Array<Bool> arr2;
+              uInt k = 0;
               ProgressMeter pm(0, nrows_p, "Saving flags");
               for(unsigned i=0;i<nrows_p;i++)
                   {
                       if (i % 16384 == 0) {
                           pm.update(i);
                       }
-                      fromFlag.get(i,arr1,true);
+                      if( k<deltarows.nelements() && deltarows[k]==i )
+                          deltaFlag.get(k++,arr1,true);
+                      else
+                          fromFlag.get(i,arr1,true);
                       if( merge.matches("and") ) {
                           toFlag.get(i,arr2,true);
-                          arr2 *= arr1;
+                          arr1 *= arr2;
                       }
                       else if (merge.matches("or")) {
                           toFlag.get(i,arr2,true);
-                          arr2 += arr1;
-                      }
-                      else if (merge.matches("replace")) {
-                          arr2.resize();
-                          arr2 = arr1;
+                          arr1 += arr2;
                       }
-                      toFlag.put(i,arr2);
+                      toFlag.put(i,arr1);
                   }
           }
    } // end if fcol_p
@@ -375,56 +399,26 @@ Bool FlagVersion::saveFlagVersion( String versionname ,
       listfile << versionname << " : " << comment << endl; 
       listfile.close();
 
-      /* Create a new Table with the standard Flag Table descriptor */
-      TableDesc td("", versionname, TableDesc::Scratch);
-      td.comment() = "TablePlot Flag Table : " + versionname;
-      
-      if(fcol_p) {
-          td.addColumn (ArrayColumnDesc<Bool> (dataflagcolname_p, 2));
-          td.defineHypercolumn("TiledFlag", 3,
-                               stringToVector(dataflagcolname_p));
-      }
-      if(frcol_p) td.addColumn (ScalarColumnDesc<Bool> (rowflagcolname_p));
-
-      SetupNewTable aNewTab(tabvername, td, Table::New);
-
-      // FLAG hyperColumn
+      /* Save the flags as a delta against the latest full version, unless
+         they differ from it in too many rows */
+      String basename = delta_p ? deltaBaseVersion() : String();
+      if( basename.empty() || !saveDeltaVersion(versionname, basename) )
       {
-          ArrayColumn<Bool> fromFlag(tab_p, dataflagcolname_p);
-          
-          /* Have to figure out the maximum cell shape,
-             i.e. max number of channels/polarizations and use that
-             to define the tile shape. There ought to be an easier way. */
-          unsigned npol_max  = fromFlag.shape(0)(0);
-          unsigned nchan_max = fromFlag.shape(0)(1);
-          {
-              unsigned nrow = tab_p.nrow();
-              for (unsigned i = 0; i < nrow; i++) {
-                  unsigned n0 = fromFlag.shape(i)(0);
-                  unsigned n1 = fromFlag.shape(i)(1);
-                  if (n0 > npol_max)  npol_max  = n0;
-                  if (n1 > nchan_max) nchan_max = n1;
-              }
-          }
-
-          uInt tile_size = 1024*1024; // bytes
-          IPosition tileShape(3, npol_max, nchan_max,
-                              tile_size*8 / (npol_max * nchan_max));
-      
-          TiledShapeStMan flagStMan("TiledFlag", tileShape);
-          aNewTab.bindColumn(dataflagcolname_p, flagStMan);
+         Table ftab = createFlagTable(versionname);
+         saveFlagsInto( tab_p, ftab, String("replace") );
       }
 
-      Table ftab(aNewTab, Table::Plain, nrows_p);
-
-      saveFlagsInto( tab_p, ftab, String("replace") );
-
       readVersionList();
    }
    
    /* Save current main flags into this version. */
    if(exists && !versionname.matches("main")) 
    {
+      /* Flags are merged into a full table, and the versions stored as
+         deltas against this one must not see it change */
+      expandFlagVersion(versionname);
+      expandDependentVersions(versionname);
+
       Table ftab(tabvername, Table::Update);
       if( ftab.nrow() != tab_p.nrow() ) 
           log->out(String("nrows don't match !! "),
@@ -449,6 +443,258 @@ Bool FlagVersion::saveFlagVersion( String versionname ,
    return true;
 }
 
+/*********************************************************************************/
+/* Number of rows of the tiles of the flag version tables: 1 MB tiles, the
+   flags being stored as bits */
+uInt FlagVersion::flagTileRows( uInt npol, uInt nchan )
+{
+   uInt tile_size = 1024*1024; // bytes
+   return MAX(tile_size*8 / (npol * nchan), 1u);
+}
+
+/*********************************************************************************/
+/* Create the table of a full flag version, tiled like the flags of the main table */
+Table FlagVersion::createFlagTable( String versionname )
+{
+   String tabvername = flagtablename_p + versionname;
+
+   /* Create a new Table with the standard Flag Table descriptor */
+   TableDesc td("", versionname, TableDesc::Scratch);
+   td.comment() = "TablePlot Flag Table : " + versionname;
+   
+   if(fcol_p) {
+       td.addColumn (ArrayColumnDesc<Bool> (dataflagcolname_p, 2));
+       td.defineHypercolumn("TiledFlag", 3,
+                            stringToVector(dataflagcolname_p));
+   }
+   if(frcol_p) td.addColumn (ScalarColumnDesc<Bool> (rowflagcolname_p));
+
+   SetupNewTable aNewTab(tabvername, td, Table::New);
+
+   // FLAG hyperColumn
+   if(fcol_p)
+   {
+       ArrayColumn<Bool> fromFlag(tab_p, dataflagcolname_p);
+       
+       /* Have to figure out the maximum cell shape,
+          i.e. max number of channels/polarizations and use that
+          to define the tile shape. There ought to be an easier way. */
+       unsigned npol_max  = fromFlag.shape(0)(0);
+       unsigned nchan_max = fromFlag.shape(0)(1);
+       {
+           unsigned nrow = tab_p.nrow();
+           for (unsigned i = 0; i < nrow; i++) {
+               unsigned n0 = fromFlag.shape(i)(0);
+               unsigned n1 = fromFlag.shape(i)(1);
+               if (n0 > npol_max)  npol_max  = n0;
+               if (n1 > nchan_max) nchan_max = n1;
+           }
+       }
+
+       IPosition tileShape(3, npol_max, nchan_max,
+                           flagTileRows(npol_max, nchan_max));
+   
+       TiledShapeStMan flagStMan("TiledFlag", tileShape);
+       aNewTab.bindColumn(dataflagcolname_p, flagStMan);
+   }
+
+   return Table(aNewTab, Table::Plain, nrows_p);
+}
+
+/*********************************************************************************/
+/* Name of the version a delta version is stored against, or an empty string
+   for a version stored in full */
+String FlagVersion::baseVersion( String versionname )
+{
+   String tabvername = flagtablename_p + versionname;
+   if( versionname.matches("main") || ! Table::isReadable(tabvername) )
+      return String();
+
+   Table ftab(tabvername);
+   if( ftab.keywordSet().isDefined(deltabasekeyword) )
+      return ftab.keywordSet().asString(deltabasekeyword);
+   return String();
+}
+
+/*********************************************************************************/
+/* The latest version stored in full, which new delta versions are stored against */
+String FlagVersion::deltaBaseVersion()
+{
+   for(Int i=(Int)versionlist_p.nelements()-1;i>0;i--)
+   {
+      if( ! versionlist_p[i].matches("main") &&
+          Table::isReadable(flagtablename_p + versionlist_p[i]) &&
+          baseVersion(versionlist_p[i]).empty() )
+         return versionlist_p[i];
+   }
+   return String();
+}
+
+/*********************************************************************************/
+/* Save the main table flags as the rows in which they differ from those of
+   the full version basename. If they differ in more than a quarter of the rows,
+   no table is written and false is returned, for a full table to be made. */
+Bool FlagVersion::saveDeltaVersion( String versionname, String basename )
+{
+   String fnname= "saveDeltaVersion";
+   Table base(flagtablename_p + basename);
+   if( base.nrow() != nrows_p ) return false;
+
+   Vector<Bool> mainrf, baserf;
+   if(frcol_p)
+   {
+      mainrf = ScalarColumn<Bool>(tab_p, rowflagcolname_p).getColumn();
+      baserf = ScalarColumn<Bool>(base, rowflagcolname_p).getColumn();
+   }
+
+   /* Find the rows that differ, giving up once there are too many */
+   uInt maxrows = nrows_p / 4;
+   std::vector<uInt> rows;
+   Bool fixedshape = true;
+   uInt chunk_rows = 0;
+   if(fcol_p)
+   {
+      ArrayColumn<Bool> mainFlag(tab_p, dataflagcolname_p);
+      ArrayColumn<Bool> baseFlag(base, dataflagcolname_p);
+      Array<Bool> arr1;
+      Array<Bool> arr2;
+
+      try {
+
+	IPosition shape(mainFlag.shape(0));
+	/* Compare large chunks at a time, as in saveFlagsInto */
+	chunk_rows = 100*1024*1024 / (shape(0) * shape(1)) + 1;
+	uInt tile_rows = flagTileRows(shape(0), shape(1));
+	chunk_rows = ((chunk_rows + tile_rows - 1) / tile_rows) * tile_rows;
+	IPosition start(3, 0, 0, 0);
+	IPosition end(3, shape(0)-1, shape(1)-1, 0);
+	for(unsigned i=0;i<nrows_p && rows.size()<=maxrows;i += chunk_rows)
+	  {
+	    unsigned j = i + chunk_rows - 1;
+	    if (!(j < nrows_p)) j = nrows_p - 1;
+	    RefRows arraySection(i, j);
+
+	    mainFlag.getColumnCells(arraySection,arr1,true);
+	    baseFlag.getColumnCells(arraySection,arr2,true);
+	    for(unsigned r=i;r<=j && rows.size()<=maxrows;r++)
+	      {
+		start(2) = end(2) = r - i;
+		if( (frcol_p && mainrf[r] != baserf[r]) ||
+		    !allEQ(arr1(start,end), arr2(start,end)) )
+		  rows.push_back(r);
+	      }
+	  }
+      }
+      catch (DataManError &e)
+          {
+              // FLAG column of non-fixed shape, see saveFlagsInto.
+              rows.clear();
+              fixedshape = false;
+              for(unsigned r=0;r<nrows_p && rows.size()<=maxrows;r++)
+                  {
+                      mainFlag.get(r,arr1,true);
+                      baseFlag.get(r,arr2,true);
+                      if( (frcol_p && mainrf[r] != baserf[r]) ||
+                          !arr1.shape().isEqual(arr2.shape()) ||
+                          !allEQ(arr1, arr2) )
+                          rows.push_back(r);
+                  }
+          }
+   }
+   else
+   {
+      for(unsigned r=0;r<nrows_p && rows.size()<=maxrows;r++)
+         if( mainrf[r] != baserf[r] ) rows.push_back(r);
+   }
+
+   if( rows.size() > maxrows ) return false;
+
+   String tabvername = flagtablename_p + versionname;
+   TableDesc td("", versionname, TableDesc::Scratch);
+   td.comment() = "TablePlot Flag Table : " + versionname + 
+                  " (rows differing from " + basename + ")";
+   td.addColumn (ScalarColumnDesc<uInt> (deltarowcolname));
+   if(fcol_p) td.addColumn (ArrayColumnDesc<Bool> (dataflagcolname_p, 2));
+   if(frcol_p) td.addColumn (ScalarColumnDesc<Bool> (rowflagcolname_p));
+
+   /* All the rows are added at once, and the columns written by slice */
+   uInt ndelta = rows.size();
+   SetupNewTable aNewTab(tabvername, td, Table::New);
+   Table dtab(aNewTab, Table::Plain, ndelta);
+   dtab.rwKeywordSet().define(deltabasekeyword, basename);
+
+   Vector<uInt> deltarows(rows);
+   ScalarColumn<uInt>(dtab, deltarowcolname).putColumn(deltarows);
+   if(frcol_p)
+   {
+      Vector<Bool> rfc(ndelta);
+      for(uInt k=0;k<ndelta;k++) rfc[k] = mainrf[rows[k]];
+      ScalarColumn<Bool>(dtab, rowflagcolname_p).putColumn(rfc);
+   }
+   if(fcol_p)
+   {
+      ArrayColumn<Bool> mainFlag(tab_p, dataflagcolname_p);
+      ArrayColumn<Bool> deltaFlag(dtab, dataflagcolname_p);
+      Array<Bool> arr1;
+      if(fixedshape)
+      {
+         for(uInt k=0;k<ndelta;k += chunk_rows)
+         {
+            uInt l = MIN(k + chunk_rows, ndelta) - 1;
+            Vector<uInt> chunk(deltarows(Slice(k, l-k+1)));
+            mainFlag.getColumnCells(RefRows(chunk),arr1,true);
+            deltaFlag.putColumnCells(RefRows(k, l),arr1);
+         }
+      }
+      else
+      {
+         for(uInt k=0;k<ndelta;k++)
+         {
+            mainFlag.get(rows[k],arr1,true);
+            deltaFlag.put(k,arr1);
+         }
+      }
+   }
+
+   log->out(String("Saved ") + String::toString(ndelta) + 
+            " rows differing from version " + basename,
+            fnname, clname, LogMessage::NORMAL);
+   dtab.flush();
+   return true;
+}
+
+/*********************************************************************************/
+/* Replace the table of a delta version by a full one. Tools reading the version
+   tables directly can use this to get the flags of a delta version. */
+Bool FlagVersion::expandFlagVersion( String versionname )
+{
+   String basename = baseVersion(versionname);
+   if( basename.empty() ) return true;
+
+   String tabvername = flagtablename_p + versionname;
+   String tmpname = versionname + ".expanding";
+   {
+      Table ftab = createFlagTable(tmpname);
+      Table base(flagtablename_p + basename);
+      Table delta(tabvername);
+      saveFlagsInto( base, ftab, String("replace"), &delta );
+   }
+
+   Table::deleteTable(tabvername);
+   Table ftab(flagtablename_p + tmpname, Table::Update);
+   ftab.rename(tabvername, Table::New);
+   return true;
+}
+
+/*********************************************************************************/
+/* Expand the delta versions stored against versionname, before it changes or goes */
+void FlagVersion::expandDependentVersions( String versionname )
+{
+   for(Int i=0;i<(Int)versionlist_p.nelements();i++)
+      if( baseVersion(versionlist_p[i]) == versionname )
+         expandFlagVersion(versionlist_p[i]);
+}
+
 /*********************************************************************************/
 Bool FlagVersion::restoreFlagVersion( String versionname, String merge )
 {
@@ -467,8 +713,20 @@ Bool FlagVersion::restoreFlagVersion( String versionname, String merge )
    /* Save current flags from this version to the main table. */
    if(exists && !versionname.matches("main")) 
    {
-      Table ftab(tabvername, Table::Update);
-      saveFlagsInto( ftab, tab_p, merge );
+      String basename = baseVersion(versionname);
+      if( basename.empty() )
+      {
+         Table ftab(tabvername, Table::Update);
+         saveFlagsInto( ftab, tab_p, merge );
+      }
+      else
+      {
+         /* Stream the base version into the main table, with the rows of
+            the delta patched in */
+         Table base(flagtablename_p + basename);
+         Table delta(tabvername);
+         saveFlagsInto( base, tab_p, merge, &delta );
+      }
    }
    
    return true;
@@ -498,6 +756,9 @@ Bool FlagVersion::deleteFlagVersion( String versionname )
       return false;
    }
    
+   /* The versions stored as deltas against this one are expanded first */
+   expandDependentVersions(versionname);
+
    /* remove the entry from the list file */
    /* delete the Table associated with it, and set version to main */
    
@@ -526,6 +787,49 @@ Bool FlagVersion::deleteFlagVersion( String versionname )
 
    return true;
 }
+/*********************************************************************************/
+Bool FlagVersion::renameFlagVersion( String oldname, String newname, String comment )
+{
+   String fnname= "renameFlagVersion";
+   if( !doesVersionExist(oldname) || oldname.matches("main") )
+   {
+      log->out(String("Flag version ") +  oldname + 
+          " does not exist", fnname, clname, LogMessage::WARN);
+      return false;
+   }
+   if( doesVersionExist(newname) || newname.matches("main") )
+   {
+      log->out(String("Flag version ") +  newname + 
+          " already exists", fnname, clname, LogMessage::WARN);
+      return false;
+   }
+
+   /* The versions stored as deltas against this one name it, and are
+      expanded first */
+   expandDependentVersions(oldname);
+
+   {
+      Table ftab(flagtablename_p + oldname, Table::Update);
+      ftab.rename(flagtablename_p + newname, Table::New);
+   }
+
+   ofstream listfile;
+   listfile.open(verlistfile_p.data());
+   for(Int i=0;i<(Int)versionlist_p.nelements();i++)
+   {
+      if( ! versionlist_p[i].matches("main") )
+      {
+         if(versionlist_p[i].matches(oldname))
+            listfile << newname << " : " << comment << endl;
+         else listfile << commentlist_p[i] << endl; 
+      }
+   }
+   listfile.close();
+
+   readVersionList();
+
+   return true;
+}
 /*********************************************************************************
 This function should be changed to not use get(i,...) and put(i, ...) instead
  of getColumn(...) and putColumn(...). Otherwise out of memory errors happen
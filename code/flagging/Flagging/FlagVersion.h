@@ -96,6 +96,18 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //
 // At the end of a "save" or "restore" operation, the latest flags are always also in
 // the main table.
+//
+// If the aipsrc variable FlagVersion.delta is true, a new version is stored as a delta
+// against the latest version stored in full: a table of the rows whose flags differ
+// from those of that base version, with their row numbers in a ROW_NUMBER column and
+// the name of the base in the FLAG_VERSION_BASE keyword. Snapshots taken between
+// flagging steps then cost a read of the base and a small write. The version is stored
+// in full instead if more than a quarter of the rows differ. Restoring a delta version
+// streams the base into the main table with the rows of the delta patched in.
+// expandFlagVersion() replaces a delta version by a full table, which tools reading the
+// version tables directly can use; it is done before flags are attached or saved into a
+// delta version, and before the base of a delta version is changed, renamed or
+// deleted. A version must be renamed with renameFlagVersion() for this to be done.
 // 
 // </synopsis>
 
@@ -145,9 +157,19 @@ class FlagVersion
       casacore::Bool restoreFlagVersion(casacore::String versionname, 
                      casacore::String merge=casacore::String("replace") );
 
+      // Replace a version stored as a delta by a full table
+      casacore::Bool expandFlagVersion( casacore::String versionname );
+
       // Delete a version. This does not touch or update the main table 
       casacore::Bool deleteFlagVersion( casacore::String versionname );
 
+      // Rename a version. The versions stored as deltas against it are expanded
+      casacore::Bool renameFlagVersion( casacore::String oldname, casacore::String newname,
+                                        casacore::String comment );
+
+      // Store new versions as deltas or not, whatever FlagVersion.delta says
+      void setDeltaVersions( casacore::Bool delta ) { delta_p = delta; }
+
       // Clear all main table flags 
       casacore::Bool clearAllFlags();
 
@@ -155,8 +177,16 @@ class FlagVersion
       void FlagVersionError( casacore::String msg );
       
       casacore::Bool readVersionList();
+      // With a delta table, its rows are patched into those of fromFTab, its base.
       casacore::Bool saveFlagsInto(casacore::Table &fromFTab, casacore::Table &toFTab, 
-                casacore::String merge = casacore::String("replace"));
+                casacore::String merge = casacore::String("replace"),
+                casacore::Table *delta = 0);
+      casacore::uInt flagTileRows( casacore::uInt npol, casacore::uInt nchan );
+      casacore::Table createFlagTable( casacore::String versionname );
+      casacore::Bool saveDeltaVersion( casacore::String versionname, casacore::String basename );
+      casacore::String baseVersion( casacore::String versionname );
+      casacore::String deltaBaseVersion();
+      void expandDependentVersions( casacore::String versionname );
       casacore::Bool doesVersionExist( casacore::String versionname );
 
       /* Variables to be maintained for the root casacore::Table */
@@ -170,6 +200,7 @@ class FlagVersion
       casacore::Vector<casacore::String> versionlist_p;
       casacore::Vector<casacore::String> commentlist_p;
       casacore::Bool fcol_p, frcol_p;
+      casacore::Bool delta_p;
       unsigned nrows_p;
 
       casacore::Table subflagtable_p;
@@ -178,6 +209,8 @@ class FlagVersion
       
       SLog* log;
       static casacore::String clname;
+      static casacore::String deltarowcolname;
+      static casacore::String deltabasekeyword;
 };
 
 } //# NAMESPACE CASA - END 
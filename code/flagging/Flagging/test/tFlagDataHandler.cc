@@ -24,6 +24,8 @@
 #include <flagging/Flagging/FlagMSHandler.h>
 #include <flagging/Flagging/FlagAgentBase.cc>
 #include <tableplot/TablePlot/FlagVersion.h>
+#include <casa/BasicMath/Math.h>
+#include <casa/Utilities/Assert.h>
 #include <iostream>
 
 using namespace casacore;
@@ -409,6 +411,161 @@ void display(string inputFile,uShort iterationMode,uShort testMode,Record record
 	cout << "Total Reading Time [s]:" << elapsedTime/1000.0 << " Total number of rows:" << cumRows <<" Total number of Buffers:" << nBuffers <<endl;
 }
 
+// Visibilities of nPols correlations that do not vanish, for the arguments to be well defined
+Cube<Complex> visCube(uInt nPols, uInt nChannels, uInt nRows, Float scale)
+{
+	Cube<Complex> vis(nPols,nChannels,nRows);
+	for (uInt row_i=0;row_i<nRows;row_i++)
+	{
+		for (uInt chan_i=0;chan_i<nChannels;chan_i++)
+		{
+			for (uInt pol_i=0;pol_i<nPols;pol_i++)
+			{
+				vis(pol_i,chan_i,row_i) = scale*Complex(1.5+pol_i+0.5*chan_i-0.3*row_i,
+														0.2*pol_i-chan_i+0.7*row_i+0.1);
+			}
+		}
+	}
+	return vis;
+}
+
+// Compare VisMapper::evaluate with the sample by sample evaluation for each correlation
+// product of expression, on views that map rows and channels, with and without diffVis
+void checkEvaluate(String expression,polarizationMap &polMap)
+{
+	uInt nPols = polMap.size();
+	Cube<Complex> left = visCube(nPols,6,5,1.0);
+	Cube<Complex> right = visCube(nPols,6,5,0.3);
+	vector<uInt> rows;
+	rows.push_back(4); rows.push_back(1); rows.push_back(3); rows.push_back(0);
+	vector<uInt> channels;
+	channels.push_back(5); channels.push_back(0); channels.push_back(2);
+
+	for (uInt diff=0;diff<2;diff++)
+	{
+		CubeView<Complex> *rightView = diff ? new CubeView<Complex>(&right,&rows,&channels) : NULL;
+		VisMapper mapper(expression,&polMap,new CubeView<Complex>(&left,&rows,&channels),rightView);
+		uInt nProducts = mapper.getSelectedCorrelations().size();
+		AlwaysAssertExit(nProducts > 0);
+
+		// A block of rows that does not start at the first one
+		uInt rowStart = 1;
+		Matrix<Float> values(channels.size(),rows.size()-rowStart);
+		for (uInt pol=0;pol<nProducts;pol++)
+		{
+			mapper.evaluate(pol,rowStart,values);
+			for (uInt row_i=0;row_i<values.ncolumn();row_i++)
+			{
+				for (uInt chan_i=0;chan_i<values.nrow();chan_i++)
+				{
+					AlwaysAssertExit(nearAbs(values(chan_i,row_i),mapper(pol,chan_i,rowStart+row_i),1e-5));
+				}
+			}
+		}
+	}
+}
+
+void checkVisMapper()
+{
+	polarizationMap linear;
+	linear[Stokes::XX] = 0; linear[Stokes::XY] = 1; linear[Stokes::YX] = 2; linear[Stokes::YY] = 3;
+	polarizationMap circular;
+	circular[Stokes::RR] = 0; circular[Stokes::RL] = 1; circular[Stokes::LR] = 2; circular[Stokes::LL] = 3;
+	polarizationMap stokes;
+	stokes[Stokes::I] = 0; stokes[Stokes::Q] = 1; stokes[Stokes::U] = 2; stokes[Stokes::V] = 3;
+	polarizationMap calsol;
+	calsol[VisMapper::CALSOL1] = 0; calsol[VisMapper::CALSOL2] = 1;
+	calsol[VisMapper::CALSOL3] = 2; calsol[VisMapper::CALSOL4] = 3;
+
+	// I, Q, U and V are HALF_SUM, HALF_DIFF and HALF_DIFF_I combinations of the
+	// linear and circular correlations; IMAG XX also selects I
+	const char *linearExpressions[] = {"ABS XX","REAL YY","ARG XY","NORM YX","IMAG XX",
+										"ABS I","REAL Q","ARG U","NORM V"};
+	for (uInt i=0;i<sizeof(linearExpressions)/sizeof(linearExpressions[0]);i++)
+		checkEvaluate(linearExpressions[i],linear);
+	const char *circularExpressions[] = {"ABS RR","REAL LL","ARG RL","NORM LR",
+										"ABS I","REAL Q","ARG U","NORM V"};
+	for (uInt i=0;i<sizeof(circularExpressions)/sizeof(circularExpressions[0]);i++)
+		checkEvaluate(circularExpressions[i],circular);
+	const char *stokesExpressions[] = {"ABS I","REAL Q","ARG U","NORM V"};
+	for (uInt i=0;i<sizeof(stokesExpressions)/sizeof(stokesExpressions[0]);i++)
+		checkEvaluate(stokesExpressions[i],stokes);
+	const char *calsolExpressions[] = {"ABS SOL1","REAL SOL2","ARG SOL3","NORM SOL4"};
+	for (uInt i=0;i<sizeof(calsolExpressions)/sizeof(calsolExpressions[0]);i++)
+		checkEvaluate(calsolExpressions[i],calsol);
+
+	cout << "VisMapper::evaluate matches the sample by sample evaluation" << endl;
+}
+
+// Compare FlagMapper::applyFlags with applyFlag and setModifiedFlags point by point
+void checkFlagMapper()
+{
+	uInt nPols = 4, nChannels = 6, nRows = 5;
+	vector<uInt> rows;
+	rows.push_back(4); rows.push_back(1); rows.push_back(3); rows.push_back(0);
+	vector<uInt> channels;
+	channels.push_back(5); channels.push_back(0); channels.push_back(2);
+
+	// A single correlation and a product of two, such as I from XX and YY
+	vector< vector<uInt> > selectedCorrelations(2);
+	selectedCorrelations[0].push_back(1);
+	selectedCorrelations[1].push_back(0);
+	selectedCorrelations[1].push_back(3);
+
+	for (uInt privateFlags=0;privateFlags<2;privateFlags++)
+	{
+		Cube<Bool> common[3], original[3], priv[3];
+		FlagMapper *mappers[3];
+		for (uInt m=0;m<3;m++)
+		{
+			common[m].resize(nPols,nChannels,nRows); common[m] = false;
+			original[m].resize(nPols,nChannels,nRows); original[m] = false;
+			priv[m].resize(nPols,nChannels,nRows); priv[m] = false;
+			mappers[m] = new FlagMapper(true,selectedCorrelations,
+										new CubeView<Bool>(&common[m],&rows,&channels),
+										new CubeView<Bool>(&original[m],&rows,&channels),
+										privateFlags ? new CubeView<Bool>(&priv[m],&rows,&channels) : NULL);
+		}
+
+		uInt rowStart = 1;
+		Matrix<Bool> mask(channels.size(),rows.size()-rowStart);
+		for (uInt pol=0;pol<selectedCorrelations.size();pol++)
+		{
+			for (uInt row_i=0;row_i<mask.ncolumn();row_i++)
+			{
+				for (uInt chan_i=0;chan_i<mask.nrow();chan_i++)
+				{
+					mask(chan_i,row_i) = (chan_i+2*row_i+pol) % 3 == 0;
+				}
+			}
+
+			uInt nFlagged = mappers[0]->applyFlags(pol,rowStart,mask);
+			AlwaysAssertExit(nFlagged == ntrue(mask));
+			for (uInt row_i=0;row_i<mask.ncolumn();row_i++)
+			{
+				for (uInt chan_i=0;chan_i<mask.nrow();chan_i++)
+				{
+					if (!mask(chan_i,row_i)) continue;
+					mappers[1]->applyFlag(pol,chan_i,rowStart+row_i);
+					mappers[2]->setModifiedFlags(pol,chan_i,rowStart+row_i);
+				}
+			}
+		}
+
+		AlwaysAssertExit(ntrue(common[0]) > 0);
+		AlwaysAssertExit(allEQ(common[0],common[1]));
+		AlwaysAssertExit(allEQ(common[0],common[2]));
+		AlwaysAssertExit(allEQ(priv[0],priv[1]));
+		AlwaysAssertExit(allEQ(original[0],false));
+		if (privateFlags) AlwaysAssertExit(allEQ(priv[0],common[0]));
+		else AlwaysAssertExit(allEQ(priv[0],false));
+
+		for (uInt m=0;m<3;m++) delete mappers[m];
+	}
+
+	cout << "FlagMapper::applyFlags matches applyFlag and setModifiedFlags" << endl;
+}
+
 int main(int argc, char **argv)
 {
 	// Variables declaration
@@ -521,6 +678,11 @@ int main(int argc, char **argv)
 		}
 	}
 
+	// The mappers are checked on cubes built here, and need no input file
+	checkVisMapper();
+	checkFlagMapper();
+	if (inputFile.empty()) return 0;
+
 	if (unflg) unflag(inputFile,iterationMode);
 	flag(inputFile,iterationMode,testMode,flagMode,record);
 	summary(inputFile,iterationMode);
@@ -0,0 +1,247 @@
+//# tFlagVersion.cc: This file contains the unit tests of the FlagVersion class.
+//#
+//#  CASA - Common Astronomy Software Applications (http://casa.nrao.edu/)
+//#  Copyright (C) Associated Universities, Inc. Washington DC, USA 2011, All rights reserved.
+//#  Copyright (C) European Southern Observatory, 2011, All rights reserved.
+//#
+//#  This library is free software; you can redistribute it and/or
+//#  modify it under the terms of the GNU Lesser General Public
+//#  License as published by the Free software Foundation; either
+//#  version 2.1 of the License, or (at your option) any later version.
+//#
+//#  This library is distributed in the hope that it will be useful,
+//#  but WITHOUT ANY WARRANTY, without even the implied warranty of
+//#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//#  Lesser General Public License for more details.
+//#
+//#  You should have received a copy of the GNU Lesser General Public
+//#  License along with this library; if not, write to the Free Software
+//#  Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+//#  MA 02111-1307  USA
+//# $Id: $
+
+#include <casa/aips.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/Arrays/Cube.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/OS/Directory.h>
+#include <casa/Utilities/Assert.h>
+#include <tables/Tables/SetupNewTab.h>
+#include <tables/Tables/ScalarColumn.h>
+#include <tables/Tables/ArrayColumn.h>
+#include <ms/MeasurementSets/MeasurementSet.h>
+#include <flagging/Flagging/FlagVersion.h>
+#include <iostream>
+
+using namespace casacore;
+using namespace casa;
+
+namespace {
+// Versions differing from their base in up to nrow/4 rows are deltas
+const uInt nrow=40;
+const Int npol=2;
+const Int nchan=4;
+const String msname="tFlagVersion_tmp.ms";
+
+struct Flags {
+	Cube<Bool> flag;
+	Vector<Bool> flagRow;
+};
+
+Flags pattern(uInt seed)
+{
+	Flags f;
+	f.flag.resize(npol, nchan, nrow);
+	f.flagRow.resize(nrow);
+	for (uInt r=0; r<nrow; r++)
+	{
+		for (Int j=0; j<nchan; j++)
+			for (Int i=0; i<npol; i++)
+				f.flag(i, j, r) = (i + 2*j + 3*r + seed) % 5 == 0;
+		f.flagRow[r] = (r + seed) % 7 == 0;
+	}
+	return f;
+}
+
+// The flags of n rows from first changed: FLAG in even rows, FLAG_ROW in odd ones
+Flags changeRows(const Flags &from, uInt first, uInt n)
+{
+	Flags f;
+	f.flag = from.flag;
+	f.flagRow = from.flagRow;
+	for (uInt r=first; r<first+n; r++)
+	{
+		if (r % 2 == 0) f.flag(0, nchan-1, r) = !f.flag(0, nchan-1, r);
+		else f.flagRow[r] = !f.flagRow[r];
+	}
+	return f;
+}
+
+Flags merged(const Flags &a, const Flags &b, const String &merge)
+{
+	Flags f;
+	if (merge == "and")
+	{
+		f.flag = a.flag && b.flag;
+		f.flagRow = a.flagRow && b.flagRow;
+	}
+	else
+	{
+		f.flag = a.flag || b.flag;
+		f.flagRow = a.flagRow || b.flagRow;
+	}
+	return f;
+}
+
+void putFlags(Table &ms, const Flags &f)
+{
+	ArrayColumn<Bool>(ms, "FLAG").putColumn(f.flag);
+	ScalarColumn<Bool>(ms, "FLAG_ROW").putColumn(f.flagRow);
+}
+
+Bool hasFlags(const Table &ms, const Flags &f)
+{
+	Array<Bool> flag = ArrayColumn<Bool>(ms, "FLAG").getColumn();
+	Vector<Bool> flagRow = ScalarColumn<Bool>(ms, "FLAG_ROW").getColumn();
+	return allEQ(flag, f.flag) && allEQ(flagRow, f.flagRow);
+}
+
+String versionTable(const String &version)
+{
+	return msname + ".flagversions/flags." + version;
+}
+
+Bool isFull(const String &version)
+{
+	Table ftab(versionTable(version));
+	return !ftab.keywordSet().isDefined("FLAG_VERSION_BASE") &&
+	       ftab.nrow() == nrow;
+}
+
+Bool isDelta(const String &version, const String &base, uInt nchanged)
+{
+	Table ftab(versionTable(version));
+	return ftab.keywordSet().isDefined("FLAG_VERSION_BASE") &&
+	       ftab.keywordSet().asString("FLAG_VERSION_BASE") == base &&
+	       ftab.nrow() == nchanged;
+}
+
+Table makeMS(const Flags &f)
+{
+	SetupNewTable newTab(msname, MS::requiredTableDesc(), Table::Scratch);
+	MeasurementSet ms(newTab, nrow);
+	ms.createDefaultSubtables(Table::Scratch);
+	putFlags(ms, f);
+	ms.flush();
+	return ms;
+}
+
+void restore(FlagVersion &fv, Table &ms, const String &version,
+             const Flags &expected)
+{
+	putFlags(ms, pattern(7));
+	fv.restoreFlagVersion(version, "replace");
+	AlwaysAssertExit(hasFlags(ms, expected));
+}
+}
+
+int main()
+{
+	Directory flagdir(msname + ".flagversions");
+	try
+	{
+		if (flagdir.exists()) flagdir.removeRecursive();
+
+		Flags f0 = pattern(0);
+		Table ms = makeMS(f0);
+		FlagVersion fv(msname, "FLAG", "FLAG_ROW");
+		fv.setDeltaVersions(true);
+
+		// Without a full version to store it against, v0 is stored in full
+		fv.saveFlagVersion("v0", "full");
+		AlwaysAssertExit(isFull("v0"));
+
+		Flags f1 = changeRows(f0, 3, 2);
+		putFlags(ms, f1);
+		fv.saveFlagVersion("v1", "delta");
+		AlwaysAssertExit(isDelta("v1", "v0", 2));
+
+		Flags f2 = changeRows(f0, 0, nrow/4);
+		putFlags(ms, f2);
+		fv.saveFlagVersion("v2", "delta at the threshold");
+		AlwaysAssertExit(isDelta("v2", "v0", nrow/4));
+
+		Flags f3 = changeRows(f0, 0, nrow/4 + 1);
+		putFlags(ms, f3);
+		fv.saveFlagVersion("v3", "full past the threshold");
+		AlwaysAssertExit(isFull("v3"));
+
+		// The latest full version is the base of the next deltas
+		Flags f4 = changeRows(f3, 20, 1);
+		putFlags(ms, f4);
+		fv.saveFlagVersion("v4", "delta");
+		AlwaysAssertExit(isDelta("v4", "v3", 1));
+
+		Flags f5 = changeRows(f3, 5, 3);
+		putFlags(ms, f5);
+		fv.saveFlagVersion("v5", "delta");
+		AlwaysAssertExit(isDelta("v5", "v3", 3));
+		cout << "Versions stored as deltas up to a quarter of the rows" << endl;
+
+		restore(fv, ms, "v0", f0);
+		restore(fv, ms, "v1", f1);
+		restore(fv, ms, "v2", f2);
+		restore(fv, ms, "v3", f3);
+		restore(fv, ms, "v4", f4);
+		restore(fv, ms, "v5", f5);
+		cout << "Full and delta versions restored" << endl;
+
+		Flags other = pattern(11);
+		const String merges[] = {"and", "or"};
+		for (uInt m=0; m<2; m++)
+		{
+			putFlags(ms, other);
+			fv.restoreFlagVersion("v0", merges[m]);
+			AlwaysAssertExit(hasFlags(ms, merged(other, f0, merges[m])));
+
+			putFlags(ms, other);
+			fv.restoreFlagVersion("v1", merges[m]);
+			AlwaysAssertExit(hasFlags(ms, merged(other, f1, merges[m])));
+		}
+		cout << "Full and delta versions merged on restore" << endl;
+
+		// Deleting or renaming a base expands the deltas stored against it
+		AlwaysAssertExit(fv.deleteFlagVersion("v3"));
+		AlwaysAssertExit(!Table::isReadable(versionTable("v3")));
+		AlwaysAssertExit(isFull("v4"));
+		AlwaysAssertExit(isFull("v5"));
+		restore(fv, ms, "v4", f4);
+		restore(fv, ms, "v5", f5);
+
+		AlwaysAssertExit(fv.renameFlagVersion("v0", "v0b", "renamed"));
+		AlwaysAssertExit(!Table::isReadable(versionTable("v0")));
+		AlwaysAssertExit(isFull("v0b"));
+		AlwaysAssertExit(isFull("v1"));
+		AlwaysAssertExit(isFull("v2"));
+		restore(fv, ms, "v0b", f0);
+		restore(fv, ms, "v1", f1);
+		restore(fv, ms, "v2", f2);
+		cout << "Deltas expanded when their base is deleted or renamed" << endl;
+
+		// The expanded versions can be bases again
+		Flags f6 = changeRows(f5, 30, 2);
+		putFlags(ms, f6);
+		fv.saveFlagVersion("v6", "delta");
+		AlwaysAssertExit(isDelta("v6", "v5", 2));
+		restore(fv, ms, "v6", f6);
+	}
+	catch (AipsError& x)
+	{
+		cout << "Exception: " << x.getMesg() << endl;
+		return 1;
+	}
+	if (flagdir.exists()) flagdir.removeRecursive();
+	cout << "OK" << endl;
+	return 0;
+}
@@ -547,125 +547,6 @@ Bool MSUVBin::fillNewBigOutputMS(){
 	return true;
 }
 
-Bool MSUVBin::fillSmallOutputMS(){
-	if(mss_p.nelements()==0)
-		throw(AipsError("No valid input MSs defined"));
-	Vector<Double> incr;
-	Vector<Int> cent;
-	Matrix<Double> uvw;
-	//need to build or recover csys at this stage
-	makeCoordsys();
-	Double reffreq=SpectralImageUtil::worldFreq(csys_p, Double(nchan_p/2));
-	Int nrrows=makeUVW(reffreq, incr, cent, uvw);
-	Cube<Complex> grid(npol_p, nchan_p, nrrows);
-	Matrix<Float> wght(npol_p, nrrows);
-	Cube<Float> wghtSpec(npol_p, nchan_p, nrrows);
-	Cube<Bool> flag(npol_p, nchan_p, nrrows);
-	Vector<Bool> rowFlag(nrrows);
-	Vector<Int> ant1(nrrows);
-	Vector<Int> ant2(nrrows);
-	Vector<Double> timeCen(nrrows);
-	createOutputMS(nrrows);
-	Matrix<Int> locuv;
-	vi::VisibilityIterator2 iter(mss_p, vi::SortColumns(), false);
-	vi::VisBuffer2* vb=iter.getVisBuffer();
-	
-	iter.originChunks();
-	iter.origin();
-	vbutil_p=VisBufferUtil(*vb);
-	if(existOut_p){
-        //recover the previous data for summing
-
-		ROMSColumns msc(*outMsPtr_p);
-		msc.data().getColumn(grid);
-		msc.weightSpectrum().getColumn(wghtSpec);
-		msc.weight().getColumn(wght);
-		msc.flag().getColumn(flag);
-		msc.flagRow().getColumn(rowFlag);
-		msc.antenna1().getColumn(ant1);
-		msc.antenna2().getColumn(ant2);
-		msc.time().getColumn(timeCen);
-		msc.uvw().getColumn(uvw);
-	}
-	else{
-		grid.set(Complex(0));
-		wght.set(0);
-		wghtSpec.set(0);
-		flag.set(true);
-		rowFlag.set(true);
-		//cerr << "SETTING time to val" << vb->time()(0) << endl;
-		timeCen.set(vb->time()(0));
-		//outMsPtr_p->addRow(nrrows, true);
-	}
-	ProgressMeter pm(1.0, Double(nrrows),"Gridding data",
-                         "", "", "", true);
-	Double rowsDone=0.0;
-	for (iter.originChunks(); iter.moreChunks(); iter.nextChunk()){
-	  for(iter.origin(); iter.more(); iter.next()){
-	    locateuvw(locuv, incr, cent, vb->uvw());
-	    gridData(*vb, grid, wght, wghtSpec,flag, rowFlag, uvw,
-		     ant1,ant2,timeCen, locuv);
-	    rowsDone+=Double(vb->nRows());
-	    pm.update(rowsDone);
-	  }
-		      
-	}
-
-	saveData(grid, flag, rowFlag, wghtSpec, wght, uvw, ant1, ant2, timeCen);
-	storeGridInfo();
-	return true;
-}
-
-Bool MSUVBin::fillBigOutputMS(){
-
-	if(mss_p.nelements()==0)
-			throw(AipsError("No valid input MSs defined"));
-	Vector<Double> incr;
-	Vector<Int> cent;
-	Matrix<Double> uvw;
-	//need to build or recover csys at this stage
-	makeCoordsys();
-	Double reffreq=SpectralImageUtil::worldFreq(csys_p, Double(nchan_p/2));
-	Int nrrows=makeUVW(reffreq, incr, cent, uvw);
-	createOutputMS(nrrows);
-	if(!existOut_p)
-	  MSColumns(*outMsPtr_p).uvw().putColumn(uvw);
-	nrrows=0;
-	for (uInt k=0; k < mss_p.nelements() ; ++k)
-	  nrrows+=(mss_p[k])->nrow();
-	
-	vi::VisibilityIterator2 iter(mss_p, vi::SortColumns(), false);
-	vi::VisBuffer2* vb=iter.getVisBuffer();
-	iter.originChunks();
-	iter.origin();
-	vbutil_p=VisBufferUtil(*vb);
-	Matrix<Int> locuv;
-	
-	ProgressMeter pm(1.0, Double(nrrows),"Gridding data",
-                         "", "", "", true);
-	Double rowsDone=0.0;
-	for (iter.originChunks(); iter.moreChunks(); iter.nextChunk()){
-				for(iter.origin(); iter.more(); iter.next()){
-	
-				  //locateuvw(locuv, incr, cent, vb->uvw());
-				  inplaceGridData(*vb);
-					//
-					//gridData(*vb, grid, wght, wghtSpec,flag, rowFlag, uvw,
-					//		ant1,ant2,timeCen, locuv);
-				  rowsDone+=Double(vb->nRows());
-				  pm.update(rowsDone);
-				}
-	}
-	
-	if(!existOut_p){
-		fillSubTables();
-	}
-	////Need to do the weight calculation here from spectral weight.
-	weightSync();
-	storeGridInfo();
-	return true;
-}
-
 Int MSUVBin::makeUVW(const Double reffreq, Vector<Double>& increment,
 		Vector<Int>& center, Matrix<Double>& uvw){
 		Vector<Int> shp(2);
@@ -790,16 +671,6 @@ void MSUVBin::makeCoordsys(){
 	csys_p.setObsInfo(obsinf);
 }
 
-void MSUVBin::locateuvw(Matrix<Int>& locuv, const Vector<Double>& increment,
-		const Vector<Int>& center, const Matrix<Double>& uvw){
-	locuv.resize(2, uvw.shape()(1));
-	for (Int k=0; k <uvw.shape()(1); ++k){
-		for(Int j=0; j < 2; ++j)
-			locuv(j,k)=Int(Double(center(j))+uvw(j,k)/increment(j)+0.5);
-	}
-
-
-}
   Bool MSUVBin::datadescMap(const vi::VisBuffer2& vb, Double& fracbw){
 	polMap_p.resize(vb.nCorrelations());
 	polMap_p.set(-1);
@@ -886,429 +757,6 @@ void MSUVBin::locateuvw(Matrix<Int>& locuv, const Vector<Double>& increment,
 	  return false;
 
 	return true;
-}
-
-  void MSUVBin::weightSync(){
-    MSColumns msc(*outMsPtr_p);
-    Matrix<Float> wght(npol_p, outMsPtr_p->nrow());
-    Matrix<Float> wghtSpec;
-    for (uInt row=0; row < outMsPtr_p->nrow(); ++row){
-      for (uInt pol=0; pol < wght.shape()(0); ++pol){
-	
-	wghtSpec=msc.weightSpectrum().get(row);
-//cerr << "shape min max "<< median(wghtSpec.xyPlane(newrow).row(pol)) << " " << min(wghtSpec.xyPlane(newrow).row(pol)) << "  "<< max(wghtSpec.xyPlane(newrow).row(pol)) << endl;
-	    wght(pol,row)=median(wghtSpec.row(pol));
-	     //cerr << "pol " << pol << " newrow "<< newrow << " weight "<< wght(pol, newrow) << endl;
-      }
-    }
-    msc.weight().putColumn(wght);	
-    Matrix<Float> sigma(wght.shape());
-    for (uInt k=0; k<wght.shape()[1]; ++k)
-      for (uInt j=0; j<wght.shape()[0]; ++j)
-	sigma(j,k)=wght(j,k)>0.0 ? 1/sqrt(wght(j,k)) :0.0;
-    msc.sigma().putColumn(sigma);
-
-
-  }
-
-void MSUVBin::inplaceGridData(const vi::VisBuffer2& vb){
-	//we need polmap and chanmap;
-        // no point of proceeding if nothing maps in this vb
-  Double fracbw;
-  if(!datadescMap(vb, fracbw)) return;
-  //cerr << "fracbw " << fracbw << endl; 
-
-  if(fracbw >0.05)
-    inplaceLargeBW(vb);
-  else
-    inplaceSmallBW(vb);
-
-
-
-		
-}
-
-  void MSUVBin::inplaceLargeBW(const vi::VisBuffer2& vb){
-	//Dang i thought the new vb will return Data or FloatData if correctedData was
-	//not there
-	Bool hasCorrected=!(ROMSMainColumns(vb.getVi()->ms()).correctedData().isNull());
-	Int nrows=vb.nRows();
-	//	Cube<Complex> grid(npol_p, nchan_p, nrows);
-	//	Matrix<Float> wght(npol_p,nrows);
-	//	Cube<Float> wghtSpec(npol_p,nchan_p,nrows);
-	//	Cube<Bool> flag(npol_p, nchan_p,nrows);
-	//	Vector<Bool> rowFlag(nrows);
-	//	Matrix<Double> uvw(3, nrows);
-	//	Vector<Int> ant1(nrows);
-	//	Vector<Int> ant2(nrows);
-	//	Vector<Double> timeCen(nrows);
-	//	Vector<uInt> rowids(nrows);
-	//cerr << outMsPtr_p.null() << endl;
-	MSColumns msc(*outMsPtr_p);
-	SpectralCoordinate spec=csys_p.spectralCoordinate(2);
-	DirectionCoordinate thedir=csys_p.directionCoordinate(0);
-	Vector<Float> scale(2);
-	scale(0)=fabs(nx_p*thedir.increment()(0))/C::c;
-	scale(1)=fabs(ny_p*thedir.increment()(1))/C::c;
-	///Index
-	Vector<Int> rowToIndex(nx_p*ny_p, -1);
-	Matrix<Int> locu(vb.nChannels(), nrows, -1);
-	Matrix<Int> locv(vb.nChannels(), nrows, -1);
-	Vector<Double> visFreq=vb.getFrequencies(0, MFrequency::LSRK);
-	Vector<Double> phasor;
-	Matrix<Double> eluvw;
-	Bool needRot=vbutil_p.rotateUVW(vb, phaseCenter_p, eluvw, phasor);
-	Int numUniq=0;
-	for (Int k=0; k <nrows; ++k){
-	  for(Int chan=0; chan < vb.nChannels(); ++chan ){
-	    if(chanMap_p(chan) >=0){
-	      locv(chan, k)=Int(Double(ny_p)/2.0+eluvw(1,k)*visFreq(chan)*scale(1)+0.5);
-	      locu(chan, k)=Int(Double(nx_p)/2.0+eluvw(0,k)*visFreq(chan)*scale(0)+0.5);
-	      Int newrow=locv(chan, k)*nx_p+locu(chan, k);
-	      if(rowToIndex[newrow] <0){ 
-		rowToIndex[newrow]=numUniq;
-		++numUniq;
-	      }
-	    }
-	  }
-	}
-	//cerr << "numrows " << vb.nRows() << " nuniq " << numUniq << endl;
-	Cube<Complex> grid(npol_p, nchan_p, numUniq);
-	Matrix<Float> wght(npol_p,numUniq);
-	Cube<Float> wghtSpec(npol_p,nchan_p,numUniq);
-	Cube<Bool> flag(npol_p, nchan_p,numUniq);
-	Vector<Bool> rowFlag(numUniq);
-	Matrix<Double> uvw(3, numUniq);
-	Vector<Int> ant1(numUniq);
-	Vector<Int> ant2(numUniq);
-	Vector<Double> timeCen(numUniq);
-	Vector<uInt> rowids(numUniq);
-	Vector<Bool> rowvisited(numUniq, false);
-	
-	Vector<Double> invLambda=visFreq/C::c;
-	Vector<Double> phasmult(vb.nChannels(),0.0);
-	Complex elphas(1.0, 0.0);
-	for (Int k=0; k < nrows; ++k){ 
-	  if(needRot)
-	    phasmult=phasor(k)*invLambda;
-	 for(Int chan=0; chan < vb.nChannels(); ++chan ){
-	   if(chanMap_p(chan) >=0){ 
-	     //Have to reject uvws out of range.
-	     if(locu(chan,k) > -1 && locu(chan, k) < nx_p && locv(chan,k)> -1 && locv(chan,k) < ny_p){
-	       Int newrow=locv(chan,k)*nx_p+locu(chan,k);
-		Int actrow=rowToIndex[newrow];
-		rowids[actrow]=uInt(newrow);
-		if(!rowvisited[actrow]){
-		  rowvisited[actrow]=true;
-		  rowFlag[actrow]=msc.flagRow()(newrow);
-		  wghtSpec[actrow]=msc.weightSpectrum().get(newrow);
-		  flag[actrow]=msc.flag().get(newrow);
-		  uvw[actrow]=msc.uvw().get(newrow);
-		  ant1[actrow]=msc.antenna1()(newrow);
-		  ant2[actrow]=msc.antenna2()(newrow);
-		  timeCen[actrow]=msc.time()(newrow);
-		  grid[actrow]=msc.data().get(newrow);
-		}
-		if(rowFlag[actrow] && !(vb.flagRow()(k))){
-		  //	  cerr << newrow << " rowFlag " << rowFlag[actrow] <<" rowids " << vb.rowIds()[k]  << " uvw2 " << uvw(2 ,actrow) << endl;
-		  rowFlag[actrow]=false;
-		  uvw(2,actrow)=eluvw(2,k);
-		  //	  cerr << newrow << " rowFlag " << rowFlag[actrow] <<" rowids " << vb.rowIds()[k]  << " uvw2 " << uvw(2 ,actrow) << endl;
-		  ant1[actrow]=vb.antenna1()(k);
-		  ant2[actrow]=vb.antenna2()(k);
-		  timeCen[actrow]=vb.time()(k);		  
-		}
-		for(Int pol=0; pol < vb.nCorrelations(); ++pol){
-		  if((!vb.flagCube()(pol,chan, k)) && (polMap_p(pol)>=0) && (vb.weight()(pol,k)>0.0)){		    
-		    Complex toB=hasCorrected ? vb.visCubeCorrected()(pol,chan,k)*vb.weight()(pol,k):
-		      vb.visCube()(pol,chan,k)*vb.weight()(pol,k);
-		    if(needRot){
-		      Double s, c;
-		      SINCOS(phasmult(chan), s, c);
-		      Complex elphas(c, s);
-		      toB *= elphas;
-		    }
-			grid(polMap_p(pol),chanMap_p(chan),actrow)
-			  = (grid(polMap_p(pol),chanMap_p(chan),actrow)*wghtSpec(polMap_p(pol),chanMap_p(chan),actrow)
-			     + toB)/(vb.weight()(pol,k)+wghtSpec(polMap_p(pol),chanMap_p(chan),actrow));
-			flag(polMap_p(pol),chanMap_p(chan),actrow)=false;
-			//cerr << "weights " << max(vb.weight()) << "  spec " << max(vb.weightSpectrum()) << endl;
-			//wghtSpec(polMap_p(pol),chanMap_p(chan), newrow)+=vb.weightSpectrum()(pol, chan, k);
-			wghtSpec(polMap_p(pol),chanMap_p(chan),actrow) += vb.weight()(pol,k);
-		  }
-		}
-	     }
-	   }
-	   //This should go for later
-	   /*for (Int pol=0; pol < wght.shape()(0); ++pol){
-	     //cerr << "shape min max "<< median(wghtSpec.xyPlane(newrow).row(pol)) << " " << min(wghtSpec.xyPlane(newrow).row(pol)) << "  "<< max(wghtSpec.xyPlane(newrow).row(pol)) << endl;
-	     wght(pol,actrow)=median(wghtSpec.xyPlane(actrow).row(pol));
-	     //cerr << "pol " << pol << " newrow "<< newrow << " weight "<< wght(pol, newrow) << endl;
-	     }*/
-	 }
-	}
-	//now lets put back the stuff
-	//cerr << "rowids " << rowids << endl;
-	RefRows elrow(rowids);
-	msc.flagRow().putColumnCells(elrow, rowFlag);
-	//reference row
-	//Matrix<Complex>matdata(grid.xyPlane(k));
-	msc.data().putColumnCells(elrow, grid);
-	//Matrix<Float> matwgt(wghtSpec.xyPlane(k));
-	msc.weightSpectrum().putColumnCells(elrow, wghtSpec);
-	//Matrix<Bool> matflag(flag.xyPlane(k));
-	msc.flag().putColumnCells(elrow, flag);
-	//Vector<Double> vecuvw(uvw.column(k));
-	msc.uvw().putColumnCells(elrow, uvw);
-	//cerr << "ant1 " << ant1 << endl;
-	msc.antenna1().putColumnCells(elrow, ant1);
-	msc.antenna2().putColumnCells(elrow, ant2);
-	msc.time().putColumnCells(elrow, timeCen);
-	//outMsPtr_p->flush(true);
-	///////
-
-
-  }
-
-  void MSUVBin::inplaceSmallBW(const vi::VisBuffer2& vb){
-	//Dang i thought the new vb will return Data or FloatData if correctedData was
-	//not there
-	Bool hasCorrected=!(ROMSMainColumns(vb.getVi()->ms()).correctedData().isNull());
-	Int nrows=vb.nRows();
-	MSColumns msc(*outMsPtr_p);
-	SpectralCoordinate spec=csys_p.spectralCoordinate(2);
-	Double refFreq;
-	spec.toWorld(refFreq, Double(nchan_p)/2.0);
-	DirectionCoordinate thedir=csys_p.directionCoordinate(0);
-	Vector<Float> scale(2);
-	scale(0)=(nx_p*thedir.increment()(0))/C::c;
-	scale(1)=(ny_p*thedir.increment()(1))/C::c;
-	///Index
-	Vector<Int> rowToIndex(nx_p*ny_p, -1);
-	Vector<Int> locu(nrows, -1);
-	Vector<Int> locv(nrows, -1);
-	Vector<Double> visFreq=vb.getFrequencies(0, MFrequency::LSRK);
-	Int numUniq=0;
-	Vector<Double> phasor;
-	Matrix<Double> eluvw;
-	eluvw=vb.uvw();
-	Bool needRot=vbutil_p.rotateUVW(vb, phaseCenter_p, eluvw, phasor);
-	//cerr << "SHAPES " << eluvw.shape() << "    " << vb.uvw().shape() << endl;
-	for (Int k=0; k <nrows; ++k){
-	  locv(k)=Int(Double(ny_p)/2.0+eluvw(1,k)*refFreq*scale(1)+0.5);
-	  locu(k)=Int(Double(nx_p)/2.0+eluvw(0,k)*refFreq*scale(0)+0.5);
-	  //cerr << "locu " << locu(k) << " locv " << locv(k) <<  " eluvw " << eluvw(0,k) << "  uvw " << vb.uvw()(0,k) << endl;
-	  if(locu(k) > -1 && locu(k) < nx_p && locv(k)> -1 && locv(k) < ny_p){
-		Int newrow=locv(k)*nx_p+locu(k);
-		if(rowToIndex[newrow] <0){ 
-		  rowToIndex[newrow]=numUniq;
-		  ++numUniq;
-		}
-	      }
-	    
-	}
-  
-	//cerr << "numrows " << vb.nRows() << " nuniq " << numUniq << endl;
-	Cube<Complex> grid(npol_p, nchan_p, numUniq);
-	Matrix<Float> wght(npol_p,numUniq);
-	Cube<Float> wghtSpec(npol_p,nchan_p,numUniq);
-	Cube<Bool> flag(npol_p, nchan_p,numUniq);
-	Vector<Bool> rowFlag(numUniq);
-	Matrix<Double> uvw(3, numUniq);
-	Vector<Int> ant1(numUniq);
-	Vector<Int> ant2(numUniq);
-	Vector<Double> timeCen(numUniq);
-	Vector<uInt> rowids(numUniq);
-	Vector<Bool> rowvisited(numUniq, false);
-	
-	Vector<Double> invLambda=visFreq/C::c;
-	for (Int k=0; k < nrows; ++k){
-	  
-	  if(locu(k) > -1 && locu(k) < nx_p && locv(k)> -1 && locv(k) < ny_p){
-	    Int newrow=locv(k)*nx_p+locu(k);
-	    Int actrow=rowToIndex[newrow];
-	    rowids[actrow]=uInt(newrow);
-	    if(!rowvisited[actrow]){
-	      rowvisited[actrow]=true;
-	      rowFlag[actrow]=msc.flagRow()(newrow);
-	      wghtSpec[actrow]=msc.weightSpectrum().get(newrow);
-	      flag[actrow]=msc.flag().get(newrow);
-	      uvw[actrow]=msc.uvw().get(newrow);
-	      ant1[actrow]=msc.antenna1()(newrow);
-	      ant2[actrow]=msc.antenna2()(newrow);
-	      timeCen[actrow]=msc.time()(newrow);
-	      grid[actrow]=msc.data().get(newrow);
-	    }
-	    if(rowFlag[actrow] && !(vb.flagRow()(k))){
-		  //	  cerr << newrow << " rowFlag " << rowFlag[actrow] <<" rowids " << vb.rowIds()[k]  << " uvw2 " << uvw(2 ,actrow) << endl;
-	      rowFlag[actrow]=false;
-	      uvw(2,actrow)=eluvw(2,k);
-	      //	  cerr << newrow << " rowFlag " << rowFlag[actrow] <<" rowids " << vb.rowIds()[k]  << " uvw2 " << uvw(2 ,actrow) << endl;
-	      ant1[actrow]=vb.antenna1()(k);
-	      ant2[actrow]=vb.antenna2()(k);
-	      timeCen[actrow]=vb.time()(k);		  
-	    }
-	    Complex elphas(1.0, 0.0);
-	    for(Int chan=0; chan < vb.nChannels(); ++chan ){
-	     
-	      if(chanMap_p(chan) >=0){ 
-		if(needRot){
-		  Double phasmult=phasor(k)*invLambda(chan);
-		  Double s, c;
-		  SINCOS(phasmult, s, c);
-		  elphas=Complex(c, s);
-		}
-		 
-		for(Int pol=0; pol < vb.nCorrelations(); ++pol){
-		  if((!vb.flagCube()(pol,chan, k)) && (polMap_p(pol)>=0) && (vb.weight()(pol,k)>0.0)){
-		    Complex toB=hasCorrected ? vb.visCubeCorrected()(pol,chan,k)*vb.weight()(pol,k):
-		      vb.visCube()(pol,chan,k)*vb.weight()(pol,k);
-		    if(needRot)
-		      toB *= elphas;
-		    grid(polMap_p(pol),chanMap_p(chan),actrow)
-			  = (grid(polMap_p(pol),chanMap_p(chan),actrow)*wghtSpec(polMap_p(pol),chanMap_p(chan),actrow)
-			     + toB)/(vb.weight()(pol,k)+wghtSpec(polMap_p(pol),chanMap_p(chan),actrow));
-		    flag(polMap_p(pol),chanMap_p(chan),actrow)=false;
-			//cerr << "weights " << max(vb.weight()) << "  spec " << max(vb.weightSpectrum()) << endl;
-			//wghtSpec(polMap_p(pol),chanMap_p(chan), newrow)+=vb.weightSpectrum()(pol, chan, k);
-		    wghtSpec(polMap_p(pol),chanMap_p(chan),actrow) += vb.weight()(pol,k);
-		  }
-		}
-	     }
-	   }
-	   //This should go for later
-	   /*for (Int pol=0; pol < wght.shape()(0); ++pol){
-	     //cerr << "shape min max "<< median(wghtSpec.xyPlane(newrow).row(pol)) << " " << min(wghtSpec.xyPlane(newrow).row(pol)) << "  "<< max(wghtSpec.xyPlane(newrow).row(pol)) << endl;
-	     wght(pol,actrow)=median(wghtSpec.xyPlane(actrow).row(pol));
-	     //cerr << "pol " << pol << " newrow "<< newrow << " weight "<< wght(pol, newrow) << endl;
-	     }*/
-	  }
-	}
-	//now lets put back the stuff
-	RefRows elrow(rowids);
-	//cerr << "ROWIDS " << rowids << endl;
-	msc.flagRow().putColumnCells(elrow, rowFlag);
-	//reference row
-	//Matrix<Complex>matdata(grid.xyPlane(k));
-	msc.data().putColumnCells(elrow, grid);
-	//Matrix<Float> matwgt(wghtSpec.xyPlane(k));
-	msc.weightSpectrum().putColumnCells(elrow, wghtSpec);
-	//Matrix<Bool> matflag(flag.xyPlane(k));
-	msc.flag().putColumnCells(elrow, flag);
-	//Vector<Double> vecuvw(uvw.column(k));
-	msc.uvw().putColumnCells(elrow, uvw);
-	//cerr << "ant1 " << ant1 << endl;
-	msc.antenna1().putColumnCells(elrow, ant1);
-	msc.antenna2().putColumnCells(elrow, ant2);
-	msc.time().putColumnCells(elrow, timeCen);
-	//outMsPtr_p->flush(true);
-	///////
-
-
-  }
-
-
-
-void MSUVBin::gridData(const vi::VisBuffer2& vb, Cube<Complex>& grid,
-		Matrix<Float>& /*wght*/, Cube<Float>& wghtSpec,
-		Cube<Bool>& flag, Vector<Bool>& rowFlag, Matrix<Double>& uvw, Vector<Int>& ant1,
-		Vector<Int>& ant2, Vector<Double>& timeCen, const Matrix<Int>& /*locuv*/){
-	//all pixel that are touched the flag and flag Row shall be unset and the w be assigned
-		//later we'll deal with multiple w for the same uv
-		//we need polmap and chanmap;
-  
-  Double fracbw;
-  if(!datadescMap(vb, fracbw)) return;
-  //cerr << "fracbw " << fracbw << endl;
-    SpectralCoordinate spec=csys_p.spectralCoordinate(2);
-    DirectionCoordinate thedir=csys_p.directionCoordinate(0);
-    Double refFreq=SpectralImageUtil::worldFreq(csys_p, Double(nchan_p/2));
-    //Double refFreq=SpectralImageUtil::worldFreq(csys_p, Double(0));
-    Vector<Float> scale(2);
-    scale(0)=fabs(nx_p*thedir.increment()(0))/C::c;
-    scale(1)=fabs(ny_p*thedir.increment()(1))/C::c;
-    //Dang i thought the new vb will return Data or FloatData if correctedData was
-	    //not there
-	    Bool hasCorrected=!(ROMSMainColumns(vb.getVi()->ms()).correctedData().isNull());
-		//locateuvw(locuv, vb.uvw());
-	    Vector<Double> visFreq=vb.getFrequencies(0, MFrequency::LSRK);
-		for (Int k=0; k < vb.nRows(); ++k){
-		  if(!vb.flagRow()[k]){
-		  Int locu, locv;
-		  {
-		    locv=Int(Double(ny_p)/2.0+vb.uvw()(1,k)*refFreq*scale(1)+0.5);
-		    locu=Int(Double(nx_p)/2.0+vb.uvw()(0,k)*refFreq*scale(0)+0.5);
-
-		  }
-		  //cerr << "fracbw " << fracbw << " pixel u " << Double(locu-nx_p/2)/refFreq/scale(0) << " data u" << vb.uvw()(0,k) <<
-		//		  " pixel v "<< Double(locv-ny_p/2)/refFreq/scale(1) << " data v "<< vb.uvw()(1,k) << endl;
-		    //Double newU=	Double(locu-nx_p/2)/refFreq/scale(0);
-		    //Double newV= Double(locv-ny_p/2)/refFreq/scale(1);
-		    //Double phaseCorr=((newU/vb.uvw()(0,k)-1)+(newV/vb.uvw()(1,k)-1))*vb.uvw()(2,k)*2.0*C::pi*refFreq/C::c;
-		    //Double phaseCorr=((newU-vb.uvw()(0,k))+(newV-vb.uvw()(1,k)))*2.0*C::pi*refFreq/C::c;
-		    //cerr << "fracbw " << fracbw << " pixel u " << Double(locu-nx_p/2)/refFreq/scale(0) << " data u" << vb.uvw()(0,k) <<
-		    //				  " pixel v "<< Double(locv-ny_p/2)/refFreq/scale(1) << " data v "<< vb.uvw()(1,k) << " phase " << phaseCorr << endl;
-		  for(Int chan=0; chan < vb.nChannels(); ++chan ){
-		    if(chanMap_p(chan) >=0){
-		      //Double outChanFreq;
-		      //spec.toWorld(outChanFreq, Double(chanMap_p(chan)));
-		      if(fracbw > 0.05)
-		      {
-		    	  locv=Int(Double(ny_p)/2.0+vb.uvw()(1,k)*visFreq(chan)*scale(1)+0.5);
-		    	  locu=Int(Double(nx_p)/2.0+vb.uvw()(0,k)*visFreq(chan)*scale(0)+0.5);
-		      }
-		      if(locv < ny_p && locu < nx_p){ 
-				  Int newrow=locv*nx_p+locu;
-				  if(rowFlag(newrow) && !(vb.flagRow()(k))){
-				    rowFlag(newrow)=false;
-				    /////TEST
-				    //uvw(0,newrow)=vb.uvw()(0,k);
-				    //uvw(1,newrow)=vb.uvw()(1,k);
-				    /////
-				    uvw(2,newrow)=vb.uvw()(2,k);
-				    //cerr << newrow << " rowids " << vb.rowIds()[k]  << " uvw2 " << uvw(2 ,newrow) << endl;
-				    ant1(newrow)=vb.antenna1()(k);
-				    ant2(newrow)=vb.antenna2()(k);
-				    timeCen(newrow)=vb.time()(k);
-
-				  }
-				  for(Int pol=0; pol < vb.nCorrelations(); ++pol){
-				    if((!vb.flagCube()(pol,chan, k)) && (polMap_p(pol)>=0) && (vb.weight()(pol,k)>0.0)){
-				  //  Double newU=	Double(locu-nx_p/2)/refFreq/scale(0);
-				 //   Double newV= Double(locv-ny_p/2)/refFreq/scale(1);
-				 //   Double phaseCorr=((newU/vb.uvw()(0,k)-1)+(newV/vb.uvw()(1,k)-1))*vb.uvw()(2,k)*2.0*C::pi*refFreq/C::c;
-				      Complex toB=hasCorrected ? vb.visCubeCorrected()(pol,chan,k)*vb.weight()(pol,k):
-					vb.visCube()(pol,chan,k)*vb.weight()(pol,k);
-				    //  Double s, c;
-				    //SINCOS(phaseCorr, s, c);
-				    //  toB=toB*Complex(c,s);
-				      grid(polMap_p(pol),chanMap_p(chan), newrow)
-					= (grid(polMap_p(pol),chanMap_p(chan), newrow)*wghtSpec(polMap_p(pol),chanMap_p(chan),newrow)
-					   + toB)/(vb.weight()(pol,k)+wghtSpec(polMap_p(pol),chanMap_p(chan),newrow));
-				      flag(polMap_p(pol),chanMap_p(chan), newrow)=false;
-				      //cerr << "weights " << max(vb.weight()) << "  spec " << max(vb.weightSpectrum()) << endl;
-				      //wghtSpec(polMap_p(pol),chanMap_p(chan), newrow)+=vb.weightSpectrum()(pol, chan, k);
-				      wghtSpec(polMap_p(pol),chanMap_p(chan), newrow) += vb.weight()(pol,k);
-				    }
-				    ///We should do that at the end totally
-				    //wght(pol,newrow)=median(wghtSpec.xyPlane(newrow).row(pol));
-				  }
-		      }//locu && locv
-		    }
-		  }
-			//sum wgtspec along channels for weight
-			/*for (Int pol=0; pol < wght.shape()(0); ++pol){
-				//cerr << "shape min max "<< median(wghtSpec.xyPlane(newrow).row(pol)) << " " << min(wghtSpec.xyPlane(newrow).row(pol)) << "  "<< max(wghtSpec.xyPlane(newrow).row(pol)) << endl;
-				wght(pol,newrow)=median(wghtSpec.xyPlane(newrow).row(pol));
-				//cerr << "pol " << pol << " newrow "<< newrow << " weight "<< wght(pol, newrow) << endl;
-			}
-			*/
-		  }
-		}
-
-
-
-
 }
 
   void MSUVBin::gridData(const vi::VisBuffer2& vb, Cube<Complex>& grid,
@@ -1322,79 +770,92 @@ void MSUVBin::gridData(const vi::VisBuffer2& vb, Cube<Complex>& grid,
   Double fracbw;
   if(!datadescMap(vb, fracbw)) return;
   //cerr << "fracbw " << fracbw << endl;
-    SpectralCoordinate spec=csys_p.spectralCoordinate(2);
     DirectionCoordinate thedir=csys_p.directionCoordinate(0);
     Double refFreq=SpectralImageUtil::worldFreq(csys_p, Double(nchan_p/2));
-    //Double refFreq=SpectralImageUtil::worldFreq(csys_p, Double(0));
     Vector<Float> scale(2);
     scale(0)=fabs(Double(nx_p)*thedir.increment()(0))/C::c;
     scale(1)=fabs(Double(ny_p)*thedir.increment()(1))/C::c;
-    //cerr << "dir incr "<< thedir.increment() << " nx ny " << nx_p << " " << ny_p << endl; 
-    //cerr << "SCALE " << scale << " fracbw " << fracbw << endl;
-
-    //cerr << "chanmap " << chanMap_p << " pol map " <<polMap_p << " weight " << wghtSpec.shape() << endl;
     //Dang i thought the new vb will return Data or FloatData if correctedData was
 	    //not there
-	    Bool hasCorrected=!(ROMSMainColumns(vb.getVi()->ms()).correctedData().isNull());
-		//locateuvw(locuv, vb.uvw());
-	    Vector<Double> visFreq=vb.getFrequencies(0, MFrequency::LSRK);
-		for (Int k=0; k < vb.nRows(); ++k){
-		  if(!vb.flagRow()[k]){
-		  Int locu, locv;
-		  {
-		    locv=Int(Double(ny_p)/2.0+vb.uvw()(1,k)*refFreq*scale(1)+0.5);
-		    locu=Int(Double(nx_p)/2.0+vb.uvw()(0,k)*refFreq*scale(0)+0.5);
+    Bool hasCorrected=!(ROMSMainColumns(vb.getVi()->ms()).correctedData().isNull());
+    Vector<Double> visFreq=vb.getFrequencies(0, MFrequency::LSRK);
+
+    //Fill the caches in the master thread
+    //// these are thread unsafe...unless already cached
+    const Vector<Bool>& vbFlagRow=vb.flagRow();
+    const Matrix<Double>& vbUvw=vb.uvw();
+    const Vector<Int>& vbAnt1=vb.antenna1();
+    const Vector<Int>& vbAnt2=vb.antenna2();
+    const Vector<Double>& vbTime=vb.time();
+    const Cube<Complex>& vbVis=hasCorrected ? vb.visCubeCorrected() : vb.visCube();
+    const Cube<Bool>& vbFlag=vb.flagCube();
+    const Matrix<Float>& vbWeight=vb.weight();
+    const Int nrows=vb.nRows();
+    const Int nvischan=vb.nChannels();
+    const Int ncorr=vb.nCorrelations();
+
+    // The uv cell of each sample is computed once here, for each row, or
+    // for each row and channel when the fractional bandwidth is large.
+    const Bool perChan=(fracbw > 0.05);
+    Matrix<Int> locU(perChan ? nvischan : 1, nrows);
+    Matrix<Int> locV(perChan ? nvischan : 1, nrows);
+    for (Int k=0; k < nrows; ++k){
+      if(vbFlagRow[k])
+	continue;
+      if(perChan){
+	for(Int chan=0; chan < nvischan; ++chan ){
+	  if(chanMap_p(chan) >=startchan && chanMap_p(chan) <=endchan){
+	    locV(chan,k)=Int(Double(ny_p)/2.0+vbUvw(1,k)*visFreq(chan)*scale(1)+0.5);
+	    locU(chan,k)=Int(Double(nx_p)/2.0+vbUvw(0,k)*visFreq(chan)*scale(0)+0.5);
+	  }
+	}
+      }
+      else{
+	locV(0,k)=Int(Double(ny_p)/2.0+vbUvw(1,k)*refFreq*scale(1)+0.5);
+	locU(0,k)=Int(Double(nx_p)/2.0+vbUvw(0,k)*refFreq*scale(0)+0.5);
+      }
+    }
 
-		  }
-		  //cerr << "fracbw " << fracbw << " pixel u " << Double(locu-nx_p/2)/refFreq/scale(0) << " data u" << vb.uvw()(0,k) <<
-		//		  " pixel v "<< Double(locv-ny_p/2)/refFreq/scale(1) << " data v "<< vb.uvw()(1,k) << endl;
-		    //Double newU=	Double(locu-nx_p/2)/refFreq/scale(0);
-		    //Double newV= Double(locv-ny_p/2)/refFreq/scale(1);
-		    //Double phaseCorr=((newU/vb.uvw()(0,k)-1)+(newV/vb.uvw()(1,k)-1))*vb.uvw()(2,k)*2.0*C::pi*refFreq/C::c;
-		    //Double phaseCorr=((newU-vb.uvw()(0,k))+(newV-vb.uvw()(1,k)))*2.0*C::pi*refFreq/C::c;
-		    //cerr << "fracbw " << fracbw << " pixel u " << Double(locu-nx_p/2)/refFreq/scale(0) << " data u" << vb.uvw()(0,k) <<
-		    //				  " pixel v "<< Double(locv-ny_p/2)/refFreq/scale(1) << " data v "<< vb.uvw()(1,k) << " phase " << phaseCorr << endl;
-		  for(Int chan=0; chan < vb.nChannels(); ++chan ){
+    // The output rows of the uv grid (row = v * nx + u) are sharded
+    // into bands of v, one per thread. Every thread goes through the
+    // whole buffer but only bins the samples falling in its own band,
+    // so all the writes to grid, flag, weights and row information are
+    // exclusive and the result does not depend on the number of threads.
+    Int nth=1;
+#ifdef _OPENMP
+    nth=min(ny_p, omp_get_max_threads());
+#endif
+#pragma omp parallel for num_threads(nth) schedule(static, 1)
+    for (Int band=0; band < nth; ++band){
+      const Int vbeg=(ny_p*band)/nth;
+      const Int vend=(ny_p*(band+1))/nth;
+		for (Int k=0; k < nrows; ++k){
+		  if(!vbFlagRow[k]){
+		  // the location is the same for all channels: skip rows outside the band
+		  if(!perChan && (locV(0,k) < vbeg || locV(0,k) >= vend))
+		    continue;
+		  for(Int chan=0; chan < nvischan; ++chan ){
 		    if(chanMap_p(chan) >=startchan && chanMap_p(chan) <=endchan){
-		      //Double outChanFreq;
-		      //spec.toWorld(outChanFreq, Double(chanMap_p(chan)));
-		      if(fracbw > 0.05)
-		      {
-		    	  locv=Int(Double(ny_p)/2.0+vb.uvw()(1,k)*visFreq(chan)*scale(1)+0.5);
-		    	  locu=Int(Double(nx_p)/2.0+vb.uvw()(0,k)*visFreq(chan)*scale(0)+0.5);
-		      }
-		      if(locv < ny_p && locu < nx_p && locv >=0 && locu >=0){
+		      const Int locu=locU(perChan ? chan : 0, k);
+		      const Int locv=locV(perChan ? chan : 0, k);
+		      if(locv < vend && locu < nx_p && locv >=vbeg && locu >=0){
 				  Int newrow=locv*nx_p+locu;
-				  if(rowFlag(newrow) && !(vb.flagRow()(k))){
+				  if(rowFlag(newrow)){
 				    rowFlag(newrow)=false;
-				    /////TEST
-				    //uvw(0,newrow)=vb.uvw()(0,k);
-				    //uvw(1,newrow)=vb.uvw()(1,k);
-				    /////
-				    uvw(2,newrow)=vb.uvw()(2,k);
-				    //cerr << newrow << " rowids " << vb.rowIds()[k]  << " uvw2 " << uvw(2 ,newrow) << endl;
-				    ant1(newrow)=vb.antenna1()(k);
-				    ant2(newrow)=vb.antenna2()(k);
-				    timeCen(newrow)=vb.time()(k);
+				    uvw(2,newrow)=vbUvw(2,k);
+				    ant1(newrow)=vbAnt1(k);
+				    ant2(newrow)=vbAnt2(k);
+				    timeCen(newrow)=vbTime(k);
 
 				  }
-				  for(Int pol=0; pol < vb.nCorrelations(); ++pol){
-				    if((!vb.flagCube()(pol,chan, k)) && (polMap_p(pol)>=0) && (vb.weight()(pol,k)>0.0)){
-				  //  Double newU=	Double(locu-nx_p/2)/refFreq/scale(0);
-				 //   Double newV= Double(locv-ny_p/2)/refFreq/scale(1);
-				 //   Double phaseCorr=((newU/vb.uvw()(0,k)-1)+(newV/vb.uvw()(1,k)-1))*vb.uvw()(2,k)*2.0*C::pi*refFreq/C::c;
-				      Complex toB=hasCorrected ? vb.visCubeCorrected()(pol,chan,k)*vb.weight()(pol,k):
-					vb.visCube()(pol,chan,k)*vb.weight()(pol,k);
-				    //  Double s, c;
-				    //SINCOS(phaseCorr, s, c);
-				    //  toB=toB*Complex(c,s);
+				  for(Int pol=0; pol < ncorr; ++pol){
+				    if((!vbFlag(pol,chan, k)) && (polMap_p(pol)>=0) && (vbWeight(pol,k)>0.0)){
+				      Complex toB=vbVis(pol,chan,k)*vbWeight(pol,k);
 				      grid(polMap_p(pol),chanMap_p(chan)-startchan, newrow)
 					= (grid(polMap_p(pol),chanMap_p(chan)-startchan, newrow)
-					   + toB); ///(vb.weight()(pol,k)+wghtSpec(polMap_p(pol),chanMap_p(chan)-startchan,newrow));
+					   + toB);
 				      flag(polMap_p(pol),chanMap_p(chan)-startchan, newrow)=false;
-				      //cerr << "weights " << max(vb.weight()) << "  spec " << max(vb.weightSpectrum()) << endl;
-				      //wghtSpec(polMap_p(pol),chanMap_p(chan), newrow)+=vb.weightSpectrum()(pol, chan, k);
-				      wghtSpec(polMap_p(pol),chanMap_p(chan)-startchan, newrow) += vb.weight()(pol,k);
+				      wghtSpec(polMap_p(pol),chanMap_p(chan)-startchan, newrow) += vbWeight(pol,k);
 				    }
 				    ///We should do that at the end totally
 				    //wght(pol,newrow)=median(wghtSpec.xyPlane(newrow).row(pol));
@@ -1402,15 +863,9 @@ void MSUVBin::gridData(const vi::VisBuffer2& vb, Cube<Complex>& grid,
 		      }//locu && locv
 		    }
 		  }
-			//sum wgtspec along channels for weight
-			/*for (Int pol=0; pol < wght.shape()(0); ++pol){
-				//cerr << "shape min max "<< median(wghtSpec.xyPlane(newrow).row(pol)) << " " << min(wghtSpec.xyPlane(newrow).row(pol)) << "  "<< max(wghtSpec.xyPlane(newrow).row(pol)) << endl;
-				wght(pol,newrow)=median(wghtSpec.xyPlane(newrow).row(pol));
-				//cerr << "pol " << pol << " newrow "<< newrow << " weight "<< wght(pol, newrow) << endl;
-			}
-			*/
 		  }
 		}
+    }
 
 
 
@@ -1635,7 +1090,6 @@ void MSUVBin::gridDataConvThr(const vi::VisBuffer2& vb, Cube<Complex>& grid,
   Int nth=1;
 #ifdef _OPENMP
   nth=min(nchan_p, omp_get_max_threads());
-  omp_set_dynamic(0);
 #endif
 #pragma omp parallel for firstprivate(refFreq, scale, hasCorrected, needRot, fracbw, gridStor, wghtSpecStor, flagStor, rowFlagStor, uvwStor, ant1Stor, ant2Stor, timeCenStor, sumweightStor, numvisStor ) shared(phasor, visFreq) num_threads(nth) schedule(dynamic, 1)
 
@@ -2070,48 +1524,6 @@ Bool MSUVBin::saveData(const Cube<Complex>& grid, const Cube<Bool>&flag, const V
 	return retval;
 
 
-}
-Bool MSUVBin::saveData(const Cube<Complex>& grid, const Cube<Bool>&flag, const Vector<Bool>& rowFlag,
-				const Cube<Float>&wghtSpec, const Matrix<Float>& /*wght*/,
-				const Matrix<Double>& uvw, const Vector<Int>& ant1,
-				const Vector<Int>& ant2, const Vector<Double>& timeCen){
-	Bool retval=true;
-	MSColumns msc(*outMsPtr_p);
-	if(!existOut_p){
-		fillSubTables();
-		msc.uvw().putColumn(uvw);
-
-	}
-
-
-	msc.data().putColumn(grid);
-	msc.weightSpectrum().putColumn(wghtSpec);
-	//msc.weight().putColumn(wght);
-	msc.flag().putColumn(flag);
-	msc.flagRow().putColumn(rowFlag);
-	msc.antenna1().putColumn(ant1);
-	msc.antenna2().putColumn(ant2);
-	Matrix<Float> weight(npol_p, wghtSpec.shape()[2]);
-	for (Int row=0; row < wghtSpec.shape()[2]; ++row){
-	  for (Int pol=0; pol < npol_p; ++pol){
-	    //cerr << "shape min max "<< median(wghtSpec.xyPlane(newrow).row(pol)) << " " << min(wghtSpec.xyPlane(newrow).row(pol)) << "  "<< max(wghtSpec.xyPlane(newrow).row(pol)) << endl;
-	    weight(pol,row)=max(wghtSpec.xyPlane(row).row(pol));
-	    //if(!rowFlag(row))
-	    //  cerr << "pol " << pol << " row "<< row << " median  "<< weight(pol, row) << " min-max " << (min(wghtSpec.xyPlane(row).row(pol))+max(wghtSpec.xyPlane(row).row(pol)))/2.0 << " mean " << mean(wghtSpec.xyPlane(row).row(pol)) << endl;
-	  }
-	}
-	msc.weight().putColumn(weight);
-	Matrix<Float> sigma(weight.shape());
-	for (uInt k=0; k<weight.shape()[1]; ++k)
-		for (uInt j=0; j<weight.shape()[0]; ++j)
-			sigma(j,k)=weight(j,k)>0.0 ? 1/sqrt(weight(j,k)) :0.0;
-	msc.sigma().putColumn(sigma);
-	msc.time().putColumn(timeCen);
-	msc.timeCentroid().putColumn(timeCen);
-
-	return retval;
-
-
 }
 void MSUVBin::fillSubTables(){
 	fillFieldTable();
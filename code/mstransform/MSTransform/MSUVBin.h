@@ -70,19 +70,11 @@ public:
 private:
 	static casacore::Int sepCommaEmptyToVectorStrings(casacore::Vector<casacore::String>& retStr,
 			  const casacore::String& str);
-	casacore::Bool fillSmallOutputMS();
 	casacore::Bool fillNewBigOutputMS();
-	casacore::Bool fillBigOutputMS();
 	casacore::Int recoverGridInfo(const casacore::String& msname);
 	void storeGridInfo();
 	void createOutputMS(const casacore::Int nrrows);
 	casacore::Int makeUVW(const casacore::Double reffreq, casacore::Vector<casacore::Double>& incr, casacore::Vector<casacore::Int>& cent, casacore::Matrix<casacore::Double>&uvw);
-	void locateuvw(casacore::Matrix<casacore::Int>& locuv, const casacore::Vector<casacore::Double>& increment,
-			const casacore::Vector<casacore::Int>& center, const casacore::Matrix<casacore::Double>& uvw);
-	void gridData(const vi::VisBuffer2& vb, casacore::Cube<casacore::Complex>& grid,
-			casacore::Matrix<casacore::Float>& wght, casacore::Cube<casacore::Float>& wghtSpec,
-			casacore::Cube<casacore::Bool>& flag, casacore::Vector<casacore::Bool>& rowFlag, casacore::Matrix<casacore::Double>& uvw, casacore::Vector<casacore::Int>& ant1,
-			casacore::Vector<casacore::Int>& ant2, casacore::Vector<casacore::Double>& time, const casacore::Matrix<casacore::Int>& locuv);
 	void gridData(const vi::VisBuffer2& vb, casacore::Cube<casacore::Complex>& grid,
 			casacore::Matrix<casacore::Float>& wght, casacore::Cube<casacore::Float>& wghtSpec,
 			casacore::Cube<casacore::Bool>& flag, casacore::Vector<casacore::Bool>& rowFlag, casacore::Matrix<casacore::Double>& uvw, casacore::Vector<casacore::Int>& ant1,
@@ -97,11 +89,7 @@ private:
 		       casacore::Cube<casacore::Bool>& flag, casacore::Vector<casacore::Bool>& rowFlag, casacore::Matrix<casacore::Double>& uvw, casacore::Vector<casacore::Int>& ant1,
 		       casacore::Vector<casacore::Int>& ant2, casacore::Vector<casacore::Double>& timeCen, const casacore::Int startchan, const casacore::Int endchan, 
 		       const casacore::Cube<casacore::Complex>& convFunc, const casacore::Vector<casacore::Int>& convSupport, const casacore::Double wScale, const casacore::Int convSampling);
-	void inplaceGridData(const vi::VisBuffer2& vb);
-	void inplaceLargeBW(const vi::VisBuffer2& vb);
-	void inplaceSmallBW(const vi::VisBuffer2& vb);
 	void makeCoordsys();
-	void weightSync();
 	void multiThrLoop(const casacore::Int outchan, const vi::VisBuffer2& vb, casacore::Double refFreq,  
 			 casacore::Vector<casacore::Float> scale, casacore::Bool hasCorrected,casacore::Bool needRot, 
 			 const casacore::Vector<casacore::Double>& phasor, const casacore::Vector<casacore::Double>& visFreq, 
@@ -118,11 +106,6 @@ private:
 	// returns a false if either no channel map or pol map onto grid
 	casacore::Bool datadescMap(const vi::VisBuffer2& vb, casacore::Double& fracbw);
 	casacore::Bool datadescMap(const VisBuffer& vb);
-	casacore::Bool saveData(const casacore::Cube<casacore::Complex>& grid, const casacore::Cube<casacore::Bool>&flag, const casacore::Vector<casacore::Bool>& rowFlag,
-					const casacore::Cube<casacore::Float>&wghtSpec, const casacore::Matrix<casacore::Float>& wght,
-					const casacore::Matrix<casacore::Double>& uvw, const casacore::Vector<casacore::Int>& ant1,
-					const casacore::Vector<casacore::Int>& ant2, const casacore::Vector<casacore::Double>& time);
-
 	casacore::Bool saveData(const casacore::Cube<casacore::Complex>& grid, const casacore::Cube<casacore::Bool>&flag, const casacore::Vector<casacore::Bool>& rowFlag,
 					const casacore::Cube<casacore::Float>&wghtSpec,
 					const casacore::Matrix<casacore::Double>& uvw, const casacore::Vector<casacore::Int>& ant1,
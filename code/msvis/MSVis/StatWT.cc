@@ -34,6 +34,7 @@
 #include <casa/Logging/LogIO.h>
 #include <ms/MSSel/MSSelection.h>
 #include <casa/Arrays/ArrayMath.h>
+#include <vector>
 
 using namespace casacore;
 namespace casa {
@@ -173,11 +174,12 @@ Bool StatWT::process(VisBuffGroup& vbg)
   // running sums of squared differences.
   std::map<uInt, Vector<Double> > variances;
 
-  // The accumulation of sums for the variances could be parallelized.
-  // See Chan, Tony F.; Golub, Gene H.; LeVeque, Randall J. (1979), "Updating
-  // Formulae and a Pairwise Algorithm for Computing Sample Variances.",
-  // Technical Report STAN-CS-79-773, Department of Computer Science, Stanford
-  // University.
+  // The sums for the variances are accumulated in parallel over baselines
+  // (see update_variances()).  Splitting a baseline's own accumulation would
+  // need the pairwise update of Chan, Tony F.; Golub, Gene H.; LeVeque,
+  // Randall J. (1979), "Updating Formulae and a Pairwise Algorithm for
+  // Computing Sample Variances.", Technical Report STAN-CS-79-773,
+  // Department of Computer Science, Stanford University.
 
   for(uInt bufnum = 0; bufnum < nvbs; ++bufnum){
     Int spw = vbg(bufnum).spectralWindow();
@@ -249,12 +251,17 @@ Bool StatWT::update_variances(std::map<uInt, Vector<uInt> >& ns,
   uInt nCorr = data.shape()[0];
   uInt nChan = data.shape()[1];
   uInt nRows = data.shape()[2];
-  Vector<uInt> unflagged(nChan);
   Vector<Int> a1(vb.antenna1());
   Vector<Int> a2(vb.antenna2());
+  const Cube<Bool>& flags(vb.flagCube());
+  const Vector<Bool>& flagrow(vb.flagRow());
+
+  // Group the unflagged rows by baseline.  The baselines are then
+  // accumulated in parallel, each taking its rows in the original order.
+  std::map<uInt, std::vector<uInt> > blrows;
 
   for(uInt r = 0; r < nRows; ++r){
-    if(!vb.flagRow()[r]){
+    if(!flagrow[r]){
       uInt hr = hashFunction(a1[r], a2[r], maxAnt);
       // setup defaults, clear on all-flagged not needed as variances == 0 is
       // skipped in apply_variances
@@ -263,13 +270,35 @@ Bool StatWT::update_variances(std::map<uInt, Vector<uInt> >& ns,
         means[hr] = Vector<Complex>(nCorr, 0);
         variances[hr] = Vector<Double>(nCorr, 0);
       }
-      Vector<uInt> & vns = ns[hr];
-      Vector<Complex> & vmeans = means[hr];
-      Vector<Double> & vvariances = variances[hr];
+      blrows[hr].push_back(r);
+    }
+  }
+
+  // The maps are not modified below, so the threads only look up their
+  // own baselines' entries.
+  std::vector<uInt> hrs;
+  hrs.reserve(blrows.size());
+  for(std::map<uInt, std::vector<uInt> >::const_iterator it = blrows.begin();
+      it != blrows.end(); ++it)
+    hrs.push_back(it->first);
+  Int nBl = hrs.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(Int bl = 0; bl < nBl; ++bl){
+    uInt hr = hrs[bl];
+    const std::vector<uInt>& rows = blrows.find(hr)->second;
+    Vector<uInt> & vns = ns.find(hr)->second;
+    Vector<Complex> & vmeans = means.find(hr)->second;
+    Vector<Double> & vvariances = variances.find(hr)->second;
+
+    for(uInt i = 0; i < rows.size(); ++i){
+      uInt r = rows[i];
 
       for(uInt corr = 0; corr < nCorr; ++corr){
         for(uInt ch = 0; ch < nChan; ++ch){
-          if(!chanmaskedflags(corr, ch, r) && !vb.flagCube()(corr,ch,r)){
+          if(!chanmaskedflags(corr, ch, r) && !flags(corr, ch, r)){
             Complex vis, vmoldmean, vmmean;
             ++vns[corr];
             vis = data(corr, ch, r);
@@ -1041,11 +1041,32 @@ VisibilityIteratorImpl2::initialize (const Block<const MeasurementSet *> &mss)
         addDataSelection (measurementSets_p [k]);
     }
 
+    // Optionally let MSIter keep the sorted row order in the MS (as its
+    // SORTED_TABLE subtable) so that re-opening the MS with the same sort
+    // columns reuses it instead of sorting all the rows again.  MSIter
+    // drops the stored order when the sort columns or the number of rows
+    // no longer match.  Only plain, writable MSs can hold it.
+    //
+    // NB: with this on, even read-only tasks write SORTED_TABLE into the MS.
+    // Several processes opening the same MS at once (e.g., the servers of
+    // an MPI tclean) then race to write and replace it, so leave it off
+    // for MSs that are shared that way.
+
+    Bool storeSorted = false;
+    casacore::AipsrcValue<Bool>::find (storeSorted,
+                                       VisibilityIterator2::getAipsRcBase () + ".StoreSortedTable", false);
+
+    for (Int k = 0; k < nMs && storeSorted; ++k) {
+
+        storeSorted = measurementSets_p [k].tableType () == Table::Plain &&
+                      measurementSets_p [k].isWritable ();
+    }
+
    msIter_p = new MSIter (measurementSets_p,
                           sortColumns_p.getColumnIds(),
                           timeInterval_p,
                           sortColumns_p.shouldAddDefaultColumns(),
-                          false);
+                          storeSorted);
 
    subtableColumns_p = new SubtableColumns (msIter_p);
 
@@ -61,6 +61,7 @@
 #include <tables/Tables/TableLock.h>
 
 #include <casa/sstream.h>
+#include <algorithm>
 
 #include <casa/Logging/LogMessage.h>
 #include <casa/Logging/LogIO.h>
@@ -69,6 +70,9 @@
 #include <imageanalysis/Annotations/RegionTextList.h>
 #include <synthesis/ImagerObjects/SDMaskHandler.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace casacore;
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -2175,11 +2179,149 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     return SHARED_PTR<ImageInterface<Float> >(fullIm);
   }
 
-  //yet another pruneRegions - using connect component labelling with depth first search alogirthm ..
+  //region labelling helpers
+
+  // representative of a provisional label in a union-find table, halving the path on the way
+  static Int findRoot(std::vector<Int>& parent, Int label)
+  {
+    while (parent[label] != label) {
+      parent[label] = parent[parent[label]];
+      label = parent[label];
+    }
+    return label;
+  }
+
+  // Two-pass connected component labelling (4-direction connectivity) of a
+  // plane of nrow x ncol pixels. Pixels that are zero in the input, or are
+  // labelled already, are left alone. The plane is cut into nstrip strips
+  // along the second axis, which get their provisional labels concurrently
+  // and are then merged along their borders. The regions are numbered from 1
+  // in the order they are first met along the rows, as a depth-first search
+  // from each unlabelled pixel would.
+  static void labelPlane(const Float* in, Float* lab, Int nrow, Int ncol, Int nstrip)
+  {
+    nstrip = max(1, min(nstrip, ncol));
+    std::vector<Int> prov(size_t(nrow)*ncol, 0);
+    std::vector<Int> stripStart(nstrip+1);
+    for (Int s = 0; s <= nstrip; ++s) stripStart[s] = Int(Int64(ncol)*s/nstrip);
+    std::vector<std::vector<Int> > parents(nstrip);
+#pragma omp parallel for num_threads(nstrip)
+    for (Int s = 0; s < nstrip; ++s)
+    {
+      std::vector<Int>& parent = parents[s];
+      parent.assign(1, 0);
+      for (Int j = stripStart[s]; j < stripStart[s+1]; ++j)
+      {
+        for (Int i = 0; i < nrow; ++i)
+        {
+          size_t idx = i + size_t(j)*nrow;
+          if (lab[idx] || !in[idx]) continue;
+          Int left = i > 0 ? prov[idx-1] : 0;
+          Int below = j > stripStart[s] ? prov[idx-nrow] : 0;
+          if (!left && !below) {
+            prov[idx] = parent.size();
+            parent.push_back(parent.size());
+            continue;
+          }
+          Int root = left ? findRoot(parent, left) : findRoot(parent, below);
+          if (left && below) {
+            Int other = findRoot(parent, below);
+            if (other < root) std::swap(other, root);
+            parent[other] = root;
+          }
+          prov[idx] = root;
+        }
+      }
+    }
+
+    // join the union-find tables of the strips, and merge the regions that
+    // touch across the strip borders
+    std::vector<Int> offset(nstrip, 0);
+    std::vector<Int> parent(1, 0);
+    for (Int s = 0; s < nstrip; ++s)
+    {
+      offset[s] = parent.size() - 1;
+      for (uInt l = 1; l < parents[s].size(); ++l) parent.push_back(parents[s][l] + offset[s]);
+    }
+#pragma omp parallel for num_threads(nstrip)
+    for (Int s = 1; s < nstrip; ++s)
+    {
+      for (size_t idx = size_t(stripStart[s])*nrow; idx < size_t(stripStart[s+1])*nrow; ++idx)
+      {
+        if (prov[idx]) prov[idx] += offset[s];
+      }
+    }
+    for (Int s = 1; s < nstrip; ++s)
+    {
+      size_t border = size_t(stripStart[s])*nrow;
+      for (Int i = 0; i < nrow; ++i)
+      {
+        Int a = prov[border + i - nrow];
+        Int b = prov[border + i];
+        if (!a || !b) continue;
+        Int ra = findRoot(parent, a);
+        Int rb = findRoot(parent, b);
+        if (ra != rb) parent[max(ra, rb)] = min(ra, rb);
+      }
+    }
+
+    // number the regions by their first pixel along the rows (i, then j)
+    std::vector<Int64> firstPix(parent.size(), -1);
+    for (Int j = 0; j < ncol; ++j)
+    {
+      for (Int i = 0; i < nrow; ++i)
+      {
+        Int p = prov[i + size_t(j)*nrow];
+        if (!p) continue;
+        Int root = findRoot(parent, p);
+        Int64 key = Int64(i)*ncol + j;
+        if (firstPix[root] < 0 || key < firstPix[root]) firstPix[root] = key;
+      }
+    }
+    std::vector<std::pair<Int64, Int> > order;
+    for (uInt l = 1; l < parent.size(); ++l)
+    {
+      if (firstPix[l] >= 0) order.push_back(std::make_pair(firstPix[l], Int(l)));
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<Int> finalLabel(parent.size(), 0);
+    for (uInt k = 0; k < order.size(); ++k) finalLabel[order[k].second] = k + 1;
+    for (size_t idx = 0; idx < prov.size(); ++idx)
+    {
+      if (prov[idx]) lab[idx] = Float(finalLabel[findRoot(parent, prov[idx])]);
+    }
+  }
+
+  // sizes of the regions labelled in a plane, the size of label k at element k-1
+  static Vector<Float> planeBlobSizes(const Float* lab, size_t npix)
+  {
+    Float maxlab = 0.0;
+    for (size_t k = 0; k < npix; ++k) maxlab = max(maxlab, lab[k]);
+    if (maxlab < 1.0) {
+      return Vector<Float>();
+    }
+    Vector<Float> blobsizes(Int(maxlab), 0);
+    for (size_t k = 0; k < npix; ++k)
+    {
+      if (lab[k]) blobsizes[Int(lab[k])-1] += 1;
+    }
+    return blobsizes;
+  }
+
+  // number of threads for the region labelling
+  static Int labelThreads()
+  {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  //yet another pruneRegions - using connect component labelling with a union-find table ..
   SHARED_PTR<casacore::ImageInterface<Float> >  SDMaskHandler::YAPruneRegions(const ImageInterface<Float>& image, Double prunesize)
   {
     LogIO os( LogOrigin("SDMaskHnadler", "YAPruneRegions",WHERE) );
-    Bool debug(False);
 
     IPosition fullimShape=image.shape();
     TempImage<Float>* fullIm = new TempImage<Float>(TiledShape(fullimShape, image.niceCursorShape()), image.coordinates(), memoryToUse());
@@ -2196,71 +2338,69 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     IPosition shp = image.shape();
     Int specaxis = CoordinateUtil::findSpectralAxis(image.coordinates());
     uInt nchan = shp(specaxis);
-    // do a single channel plane at time
+    Int nx = shp(0);
+    Int ny = shp(1);
+    size_t npix = size_t(nx)*ny;
+    size_t chanStride = npix*shp(2);
+    // The channel planes are read and written a batch at a time on this
+    // thread, and the planes of a batch are labelled and pruned concurrently.
+    // A batch of a single plane is labelled in strips by all the threads.
     //  - assumes standard CASA image axis ordering (ra,dec,stokes,chan)
-    for (uInt ich = 0; ich < nchan; ich++) {
-      IPosition start(4, 0, 0, 0,ich);
-      IPosition length(4, shp(0),shp(1),shp(2),1);
-      Slicer sl(start, length);
-      //cerr<<"ich="<<ich<<" slicer sl ="<<sl<<endl;
-      AxesSpecifier aspec(False);
-      // following works if stokes axis dim = 1
-      SubImage<Float>* subIm = new SubImage<Float>(image, sl, aspec, True);
-
-      IPosition subimShape=subIm->shape();
-      TempImage<Float>* tempIm = new TempImage<Float> (TiledShape(subIm->shape(), subIm->niceCursorShape()), subIm->coordinates(), memoryToUse() );
+    //  - only the first stokes plane is labelled and pruned, as labelRegions does
+    Int nthreads = labelThreads();
+    uInt nbatch = min(nchan, uInt(nthreads));
+    for (uInt ich0 = 0; ich0 < nchan; ich0 += nbatch) {
+      uInt nb = min(nbatch, nchan - ich0);
+      IPosition start(4, 0, 0, 0, ich0);
+      IPosition length(4, shp(0), shp(1), shp(2), nb);
       // to search for both positive and negative components
-      tempIm->copyData(LatticeExpr<Float> (abs(*subIm)));
-
-      TempImage<Float>* blobMap = new TempImage<Float> (TiledShape(subIm->shape(), subIm->niceCursorShape()), subIm->coordinates(), memoryToUse() );
-      blobMap->set(0);
-
-      // connected componet labelling
-      os<<LogIO::DEBUG1<<"Calling labelRegions..."<<LogIO::POST;
-      labelRegions(*tempIm, *blobMap);
-      os<<LogIO::DEBUG1<<"Calling findBlobSize..."<<LogIO::POST;
-      // get blobsizes (the vector contains each labeled region size (label # = ith element+1)
-      Vector<Float> blobsizes = findBlobSize(*blobMap);
-      //use ImageDecomposer
-      // book keeping of no of  removed components`
-      uInt removeBySize=0;
-      Bool hasMask(True);
-      //cerr<<"blobsizes.nelements()="<<blobsizes.nelements()<<endl; 
-      //removing operations
-      if (blobsizes.nelements()) {
-        if (prunesize > 0.0) {
+      Array<Float> planes = abs(image.getSlice(start, length));
+      Bool delPlanes;
+      Float* pix = planes.getStorage(delPlanes);
+      // book keeping of no of regions and of removed components
+      std::vector<uInt> nblobs(nb, 0);
+      std::vector<uInt> removeBySize(nb, 0);
+      Int nstrip = nb > 1 ? 1 : nthreads;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic) if(nb > 1)
+      for (Int ib = 0; ib < Int(nb); ++ib) {
+        Float* plane = pix + ib*chanStride;
+        // connected componet labelling
+        std::vector<Float> blobMap(npix, 0.0);
+        labelPlane(plane, blobMap.data(), nx, ny, nstrip);
+        // get blobsizes (the vector contains each labeled region size (label # = ith element+1)
+        Vector<Float> blobsizes = planeBlobSizes(blobMap.data(), npix);
+        nblobs[ib] = blobsizes.nelements();
+        //removing operations
+        if (blobsizes.nelements() && prunesize > 0.0) {
+          // mark the regions to remove, then clear them in a single pass
+          std::vector<Bool> toRemove(blobsizes.nelements(), False);
           for (uInt icomp = 0; icomp < blobsizes.nelements(); ++icomp) {
             if ( blobsizes[icomp] < prunesize ) {
-              Float blobid = Float(icomp+1);
-              removeBySize++;
-              tempIm->copyData( (LatticeExpr<Float>)( iif(*blobMap == blobid, 0.0, *tempIm  ) ) );
+              toRemove[icomp] = True;
+              removeBySize[ib]++;
+            }
+          }
+          if (removeBySize[ib]>0) {
+            for (size_t k = 0; k < npix; ++k) {
+              if (blobMap[k] > 0 && toRemove[Int(blobMap[k])-1]) plane[k] = 0.0;
             }
           }
         }
       }
-      else {
-        hasMask=False;
-      }
+      planes.putStorage(pix, delPlanes);
+      fullIm->putSlice(planes, start);
+
       // log reporting ...
-      if (removeBySize>0) {
-        os <<LogIO::NORMAL<<"pruneRegions removed "<<removeBySize<<" regions (out of "<<blobsizes.nelements()<<" ) from the mask image. "<<LogIO::POST;
-      }
-      else {
-        if (hasMask) {
-          os <<LogIO::NORMAL<<"No regions are removed in pruning process." << LogIO::POST;
+      for (uInt ib = 0; ib < nb; ++ib) {
+        if (removeBySize[ib]>0) {
+          os <<LogIO::NORMAL<<"pruneRegions removed "<<removeBySize[ib]<<" regions (out of "<<nblobs[ib]<<" ) from the mask image. "<<LogIO::POST;
+        }
+        else {
+          if (nblobs[ib]) {
+            os <<LogIO::NORMAL<<"No regions are removed in pruning process." << LogIO::POST;
+          }
         }
       }
-
-      // Debug
-      if (debug) {
-        PagedImage<Float> tempBlobMap(blobMap->shape(), blobMap->coordinates(), "tmp-Blob.map");
-        tempBlobMap.copyData(*blobMap);
-      }
-      Array<Float> subimData;
-      tempIm->getSlice(subimData,IPosition(2,0), tempIm->shape(), IPosition(2,1,1));
-      fullIm->putSlice(subimData,start,IPosition(4,1,1,1,1));
-      delete tempIm; tempIm=0;
-      delete subIm; subIm=0;
     }
     return SHARED_PTR<ImageInterface<Float> >(fullIm);
   }
@@ -2374,12 +2514,16 @@ namespace casa { //# NAMESPACE CASA - BEGIN
       // if masks are true do binary dilation...
       if (ntrue(planeMask)>0 && chanmask(ipch)) {
       //cerr<<"planeImage.shape()="<<planeImage.shape()<<endl;
-      for (Int i=0; i < nx; i++) {
-        for (Int j=0; j < ny; j++) {
-          if (planeImage(IPosition(4,i,j,0,0))==1.0 && planeMask(IPosition(4,i,j,0,0)) ) {
+      // the plane pixels are accessed through their storage, (i,j) at i+j*nx
+      Bool delImage, delMask;
+      Float* pix = planeImage.getStorage(delImage);
+      const Bool* pmask = planeMask.getStorage(delMask);
+      for (Int j=0; j < ny; j++) {
+        for (Int i=0; i < nx; i++) {
+          if (pix[i+j*nx]==1.0 && pmask[i+j*nx] ) {
             //cerr<<"if planeImage ==1 i="<<i<<" j="<<j<<endl;
             // Set the value for se(1,1)
-            planeImage(IPosition(4,i,j,0,0)) = 2.0;
+            pix[i+j*nx] = 2.0;
             for (Int ise=0; ise < se_nx; ise++) {
               for (Int jse = 0; jse < se_ny; jse++) {
                 Int relx_se = ise - 1;
@@ -2388,9 +2532,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
                   //cerr<<"structure("<<ise<<","<<jse<<")="<<structure(IPosition(2,ise,jse))<<endl; 
                   if ((i + relx_se) >= 0 && (i + relx_se) < nx &&
                       (j + rely_se) >= 0 && (j + rely_se) < ny) {
-                    if (planeImage(IPosition(4,i+relx_se,j+rely_se,0,0))==0 ) {
+                    if (pix[i+relx_se+(j+rely_se)*nx]==0 ) {
                       // set to 2.0 to make distinction with the orignal 1.0 pixels
-                      planeImage(IPosition(4, i+relx_se, j+rely_se,0,0))=2.0;
+                      pix[i+relx_se+(j+rely_se)*nx]=2.0;
                       //cerr<<" i+relx_se="<<i+relx_se<<" j+rely_se="<<j+rely_se<<endl;
                     }                   
                   }
@@ -2400,12 +2544,11 @@ namespace casa { //# NAMESPACE CASA - BEGIN
           } // S.E. row loop
         } // image col loop
       } //inage row loop
-      for (Int ii=0; ii < nx; ii++) {
-        for (Int jj=0; jj < ny; jj++) {
-          if (planeImage(IPosition(4,ii,jj,0,0))==2) 
-            planeImage(IPosition(4,ii,jj,0,0))=1;
-        }
+      for (Int k=0; k < nx*ny; k++) {
+        if (pix[k]==2) pix[k]=1;
       }
+      planeMask.freeStorage(pmask, delMask);
+      planeImage.putStorage(pix, delImage);
       } // if ntrure() ...
       oli.woCursor() = planeImage;
     }
@@ -2492,50 +2635,26 @@ namespace casa { //# NAMESPACE CASA - BEGIN
   }// end of autoMaskWithinPB
 
   //region labelling code
-  void SDMaskHandler::depthFirstSearch(Int x, 
-                                       Int y, 
-                                       Int cur_label, 
-                                       Lattice<Float>& inlat, 
-                                       Lattice<Float>& lablat)
-  {
-    Vector<Int> dx(4);
-    Vector<Int> dy(4);
-    // 4-direction connectivity
-    dx(0) = 1; dx(1)=0;dx(2)=-1;dx(3)=0;
-    dy(0) = 0; dy(1)=1;dy(2)=0;dy(3)=-1;
-    
-    IPosition inshape = inlat.shape();
-    Int nrow = inshape(0);
-    Int ncol = inshape(1);
-    // out of bound condition
-    if(x < 0 || x == nrow) return;
-    if(y < 0 || y == ncol) return;
-    IPosition loc(4,x,y,0,0);
-    // already labelled or not value 1 pixel 
-    if(lablat(loc) || !inlat(loc)) return;
-   
-    //lablat(loc) = cur_label;
-    //cerr<<"cur_label="<<cur_label<<" loc="<<loc<<endl;
-    lablat.putAt(Float(cur_label), loc);
-    //recursively check the neighbor 
-    for (uInt inc = 0; inc < 4; ++inc) 
-      depthFirstSearch(x + dx[inc], y + dy[inc], cur_label, inlat, lablat);
-  }
-
   void SDMaskHandler::labelRegions(Lattice<Float>& inlat, Lattice<Float>& lablat) 
   {
-    Int blobId = 0;
+    // labelling of the first plane, see labelPlane
     IPosition inshape = inlat.shape();
     Int nrow = inshape(0);
     Int ncol = inshape(1);
-    for (Int i = 0; i < nrow; ++i)
-    { 
-      for (Int j = 0; j < ncol; ++j) 
-      {
-        if (!lablat(IPosition(4,i,j,0,0)) && inlat(IPosition(4,i,j,0,0) ) ) 
-          depthFirstSearch(i, j, ++blobId, inlat, lablat);
-      }
-    }
+    IPosition origin(inshape.nelements(), 0);
+    IPosition planeShape(inshape.nelements(), 1);
+    planeShape(0) = nrow;
+    planeShape(1) = ncol;
+    Array<Float> inplane, labplane;
+    inlat.getSlice(inplane, origin, planeShape);
+    lablat.getSlice(labplane, origin, planeShape);
+    Bool delIn, delLab;
+    const Float* in = inplane.getStorage(delIn);
+    Float* lab = labplane.getStorage(delLab);
+    labelPlane(in, lab, nrow, ncol, labelThreads());
+    inplane.freeStorage(in, delIn);
+    labplane.putStorage(lab, delLab);
+    lablat.putSlice(labplane, origin);
   }
 
   Vector<Float> SDMaskHandler::findBlobSize(Lattice<Float>& lablat) 
@@ -2550,21 +2669,17 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     IPosition inshape = lablat.shape();
     Int nrow = inshape(0);
     Int ncol = inshape(1);
-    LatticeExprNode leMax=max(lablat);
-    Float maxlab = leMax.getFloat();
-    if (maxlab < 1.0) {
-      return Vector<Float>();  
-    }
-    Vector<Float> blobsizes(Int(maxlab),0);
-    for (Int i = 0; i < nrow; ++i) 
-    { 
-      for (Int j =0; j < ncol; ++j)
-      {
-        IPosition loc(4, i, j, 0, 0);
-        //cerr<<"i="<<i<<" j="<<j<<" labelat(loc)="<<lablat(loc)<<endl;
-        if (lablat(loc)) blobsizes[Int(lablat(loc))-1]+=1;
-      }
-    }
+    IPosition origin(inshape.nelements(), 0);
+    IPosition planeShape(inshape.nelements(), 1);
+    planeShape(0) = nrow;
+    planeShape(1) = ncol;
+    Array<Float> labplane;
+    lablat.getSlice(labplane, origin, planeShape);
+    Bool deleteIt;
+    const Float* labels = labplane.getStorage(deleteIt);
+    Vector<Float> blobsizes = planeBlobSizes(labels, labplane.nelements());
+    labplane.freeStorage(labels, deleteIt);
+    Int maxlab = blobsizes.nelements();
 
     //for debug
     for (Int k = 0;k < maxlab; ++k) 
@@ -209,7 +209,7 @@ public:
                                                    casacore::Int nmask=0,
                                                    casacore::Double prunesize=0.0);
 
-  // Yet another Prune the mask regions per spectral plane
+  // Yet another Prune the mask regions per spectral plane (the planes are pruned concurrently)
   SHARED_PTR<casacore::ImageInterface<float> >  YAPruneRegions(const casacore::ImageInterface<casacore::Float>& image,
                                                    casacore::Double prunesize=0.0);
 
@@ -257,15 +257,8 @@ public:
                         casacore::Float pblimit=0.1);
 
   
-  // depth-first-search algorithm for 2D 
-  // input lattice can by 3d or 4d but only search is done on the first plane 
-  void depthFirstSearch(casacore::Int x,
-                        casacore::Int y,
-                        casacore::Int cur_label,
-                        casacore::Lattice<casacore::Float>& inlat,
-                        casacore::Lattice<casacore::Float>& lablat);
-
-  // label connected regions using depth-first-search algorithm
+  // label connected regions (two-pass labelling with a union-find table)
+  // input lattice can by 3d or 4d but only labelling is done on the first plane 
   void labelRegions(casacore::Lattice<casacore::Float>& inlat, casacore::Lattice<casacore::Float>& lablat); 
 
   // find sizes of bolbs (regions) found by labelRegions 
@@ -560,7 +560,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
   void SIImageStore::buildImage(SHARED_PTR<ImageInterface<Float> > &imptr,IPosition shape, CoordinateSystem csys, String name)
   {
     itsOpened++;
-    imptr.reset( new PagedImage<Float> (shape, csys, name) );
+    imptr.reset( new PagedImage<Float> (TiledShape(shape, tileShape(shape, name)), csys, name) );
+    setPlaneCache( *imptr );
     
     ImageInfo info = imptr->imageInfo();
     String objectName("");
@@ -590,6 +591,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
     itsOpened++;
     imptr.reset( new PagedImage<Float>( name ) );
+    setPlaneCache( *imptr );
 
     /*
     IPosition cimageShape;
@@ -1028,7 +1030,45 @@ namespace casa { //# NAMESPACE CASA - BEGIN
   }
   IPosition SIImageStore::tileShape(){
 	  //Need to have settable stuff here or algorith to determine this
-	  return IPosition(4, min(itsImageShape[0],1000), min(itsImageShape[1],1000), 1, 1);
+	  return tileShape(itsImageShape);
+  }
+  IPosition SIImageStore::tileShape(const IPosition& shape){
+	  // Tiles of the internal images never span more than one plane, so that
+	  // the per-channel and per-pol slices read in the major and minor cycles
+	  // touch only their own plane.
+	  return IPosition(4, min(shape[0],1000), min(shape[1],1000), 1, 1);
+  }
+  IPosition SIImageStore::tileShape(const IPosition& shape, const String& name){
+	  // The weight images are only used by the imager, and get plane tiles.
+	  if( name.contains(imageExts(SUMWT)) || name.contains(imageExts(WEIGHT)) ||
+	      name.contains(imageExts(GRIDWT)) )
+	    {
+	      return tileShape(shape);
+	    }
+	  // The other images are products that are also read along the spectral
+	  // axis once imaging is done.  Their tiles span a few channels: a plane
+	  // read then brings the next channels of the sweep into the tile cache,
+	  // while a spectrum reads nchan/4 tiles instead of nchan whole planes.
+	  return IPosition(4, min(shape[0],512), min(shape[1],512), 1, min(shape[3],4));
+  }
+
+  // Hold only the tiles that cover one plane (or the few channels of one
+  // row of tiles) in the tile cache of an image on disk.  This is all that
+  // a channel-by-channel sweep needs, and keeps the cache of each image
+  // from growing with the size of the cube.  The maximum cache size is set
+  // as well, so that the lattice iterators used on the image later cannot
+  // grow the cache beyond this.
+  void SIImageStore::setPlaneCache(ImageInterface<Float>& image)
+  {
+    IPosition shp( image.shape() ), tile( image.niceCursorShape() );
+    uInt nTiles=1;
+    for(uInt axis=0; axis<2 && axis<shp.nelements(); axis++)
+      {
+	nTiles *= (shp[axis] + tile[axis] - 1) / tile[axis];
+      }
+    Int64 cachePixels = min( Int64(nTiles) * tile.product(), Int64(0xffffffffu) );
+    image.setMaximumCacheSize( uInt(cachePixels) );
+    image.setCacheSizeInTiles( nTiles );
   }
 
   // TODO : Move to an image-wrapper class ? Same function exists in SynthesisDeconvolver.
@@ -1093,6 +1133,57 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
   }
 
+  // Sum of this store's images and those of all the parts is evaluated as one
+  // expression, so each image of this store is read and written only once.
+  void SIImageStore::addImages( const Vector<SHARED_PTR<SIImageStore> >& imagestoadd,
+				Bool addpsf, Bool addresidual, Bool addweight, Bool adddensity)
+  {
+    if( imagestoadd.nelements()==0 ) return;
+
+    if(addpsf)
+      {
+	LatticeExprNode adderPsf( *(psf()) );
+	for( uInt part=0;part<imagestoadd.nelements();part++)
+	  adderPsf = adderPsf + LatticeExprNode( *(imagestoadd[part]->psf()) );
+	psf()->copyData( LatticeExpr<Float>(adderPsf) );
+      }
+    if(addresidual)
+      {
+	LatticeExprNode adderRes( *(residual()) );
+	for( uInt part=0;part<imagestoadd.nelements();part++)
+	  adderRes = adderRes + LatticeExprNode( *(imagestoadd[part]->residual()) );
+	residual()->copyData( LatticeExpr<Float>(adderRes) );
+      }
+    if(addweight)
+      {
+	Vector<Bool> useWeight( imagestoadd.nelements() );
+	for( uInt part=0;part<imagestoadd.nelements();part++)
+	  useWeight[part] = getUseWeightImage( *(imagestoadd[part]->sumwt()) );
+
+	if( anyTrue(useWeight) ) // Access and add weight only if it is needed.
+	  {
+	    LatticeExprNode adderWeight( *(weight()) );
+	    for( uInt part=0;part<imagestoadd.nelements();part++)
+	      if( useWeight[part] ) adderWeight = adderWeight + LatticeExprNode( *(imagestoadd[part]->weight()) );
+	    weight()->copyData( LatticeExpr<Float>(adderWeight) );
+	  }
+
+	LatticeExprNode adderSumWt( *(sumwt()) );
+	for( uInt part=0;part<imagestoadd.nelements();part++)
+	  adderSumWt = adderSumWt + LatticeExprNode( *(imagestoadd[part]->sumwt()) );
+	sumwt()->copyData( LatticeExpr<Float>(adderSumWt) );
+	setUseWeightImage( *sumwt(), useWeight[imagestoadd.nelements()-1] );
+      }
+    if(adddensity)
+      {
+	LatticeExprNode adderDensity( *(gridwt()) );
+	for( uInt part=0;part<imagestoadd.nelements();part++)
+	  adderDensity = adderDensity + LatticeExprNode( *(imagestoadd[part]->gridwt()) );
+	gridwt()->copyData( LatticeExpr<Float>(adderDensity) );
+      }
+
+  }
+
 void SIImageStore::setWeightDensity( SHARED_PTR<SIImageStore> imagetoset )
   {
     LogIO os( LogOrigin("SIImageStore","setWeightDensity",WHERE) );
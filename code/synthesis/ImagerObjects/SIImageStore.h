@@ -123,6 +123,9 @@ class SIImageStore
   virtual void resetImages( casacore::Bool resetpsf, casacore::Bool resetresidual, casacore::Bool resetweight );
   virtual void addImages( SHARED_PTR<SIImageStore> imagestoadd, 
 			  casacore::Bool addpsf, casacore::Bool addresidual, casacore::Bool addweight, casacore::Bool adddensity );
+  // Add all the given (partial) images in a single pass over each image of this store
+  virtual void addImages( const casacore::Vector<SHARED_PTR<SIImageStore> >& imagestoadd, 
+			  casacore::Bool addpsf, casacore::Bool addresidual, casacore::Bool addweight, casacore::Bool adddensity );
 
   ///// Normalizers
   virtual void dividePSFByWeight(const casacore::Float pblimit=casacore::C::minfloat);
@@ -215,6 +218,9 @@ protected:
 
   casacore::Double memoryBeforeLattice();
   casacore::IPosition tileShape();
+  casacore::IPosition tileShape(const casacore::IPosition& shape);
+  casacore::IPosition tileShape(const casacore::IPosition& shape, const casacore::String& name);
+  void setPlaneCache(casacore::ImageInterface<casacore::Float>& image);
 
   void regridToModelImage(casacore::ImageInterface<casacore::Float> &inputimage, casacore::Int term=0 );
 
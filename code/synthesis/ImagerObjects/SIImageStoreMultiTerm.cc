@@ -798,6 +798,62 @@ namespace casa { //# NAMESPACE CASA - BEGIN
       }
   }
 
+  // As SIImageStore::addImages for a list of parts, for all the terms.
+  void SIImageStoreMultiTerm::addImages( const Vector<SHARED_PTR<SIImageStore> >& imagestoadd,
+					 Bool addpsf, Bool addresidual, Bool addweight, Bool adddensity)
+  {
+    if( imagestoadd.nelements()==0 ) return;
+    uInt nparts = imagestoadd.nelements();
+
+    for(uInt tix=0;tix<2*itsNTerms-1;tix++)
+      {
+	
+	if(addpsf)
+	  {
+	    LatticeExprNode adderPsf( *(psf(tix)) );
+	    for(uInt part=0;part<nparts;part++)
+	      adderPsf = adderPsf + LatticeExprNode( *(imagestoadd[part]->psf(tix)) );
+	    psf(tix)->copyData( LatticeExpr<Float>(adderPsf) );
+	  }
+	if(addweight)
+	  {
+	    Vector<Bool> useWeight( nparts );
+	    for(uInt part=0;part<nparts;part++)
+	      useWeight[part] = getUseWeightImage( *(imagestoadd[part]->sumwt(tix)) );
+
+	    if( anyTrue(useWeight) ) // Access and add weight only if it is needed.
+	      {
+		LatticeExprNode adderWeight( *(weight(tix)) );
+		for(uInt part=0;part<nparts;part++)
+		  if( useWeight[part] ) adderWeight = adderWeight + LatticeExprNode( *(imagestoadd[part]->weight(tix)) );
+		weight(tix)->copyData( LatticeExpr<Float>(adderWeight) );
+	      }
+
+	    LatticeExprNode adderSumWt( *(sumwt(tix)) );
+	    for(uInt part=0;part<nparts;part++)
+	      adderSumWt = adderSumWt + LatticeExprNode( *(imagestoadd[part]->sumwt(tix)) );
+	    sumwt(tix)->copyData( LatticeExpr<Float>(adderSumWt) );
+	  }
+
+	if(tix < itsNTerms && addresidual)
+	  {
+	    LatticeExprNode adderRes( *(residual(tix)) );
+	    for(uInt part=0;part<nparts;part++)
+	      adderRes = adderRes + LatticeExprNode( *(imagestoadd[part]->residual(tix)) );
+	    residual(tix)->copyData( LatticeExpr<Float>(adderRes) );
+	  }
+
+	if( tix==0 && adddensity )
+	  {
+	    LatticeExprNode adderDensity( *(gridwt()) );
+	    for(uInt part=0;part<nparts;part++)
+	      adderDensity = adderDensity + LatticeExprNode( *(imagestoadd[part]->gridwt()) );
+	    gridwt()->copyData( LatticeExpr<Float>(adderDensity) );
+	  }
+
+      }
+  }
+
   void SIImageStoreMultiTerm::dividePSFByWeight(const Float /*pblimit*/)
   {
     LogIO os( LogOrigin("SIImageStoreMultiTerm","dividePSFByWeight",WHERE) );
@@ -125,6 +125,8 @@ namespace casa { //# NAMESPACE CASA - BEGIN
   void resetImages( casacore::Bool resetpsf, casacore::Bool resetresidual, casacore::Bool resetweight );
   void addImages( SHARED_PTR<SIImageStore> imagestoadd, 
 		  casacore::Bool addpsf, casacore::Bool addresidual, casacore::Bool addweight, casacore::Bool adddensity);
+  void addImages( const casacore::Vector<SHARED_PTR<SIImageStore> >& imagestoadd, 
+		  casacore::Bool addpsf, casacore::Bool addresidual, casacore::Bool addweight, casacore::Bool adddensity);
 
   void dividePSFByWeight(const casacore::Float pblimit=casacore::C::minfloat);
   void normalizePrimaryBeam(const float pblimit=casacore::C::minfloat);
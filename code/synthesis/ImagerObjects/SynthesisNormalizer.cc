@@ -169,9 +169,10 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 	// Add intelligence to modify all only the first time, but later, only residual;
 	itsImages->resetImages( /*psf*/dopsf, /*residual*/doresidual, /*weight*/doweight ); 
 	
+	// All parts are summed in one pass over each gathered image.
+	itsImages->addImages( itsPartImages, /*psf*/dopsf, /*residual*/doresidual, /*weight*/doweight, /*griddedwt*/dodensity );
 	for( uInt part=0;part<itsPartImages.nelements();part++)
 	  {
-	    itsImages->addImages( itsPartImages[part], /*psf*/dopsf, /*residual*/doresidual, /*weight*/doweight, /*griddedwt*/dodensity );
 	    itsPartImages[part]->releaseLocks();
 	  }
 
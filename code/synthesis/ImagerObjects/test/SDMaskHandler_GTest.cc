@@ -22,6 +22,9 @@
 #include <synthesis/ImagerObjects/SDMaskHandler.h>
 #include <images/Regions/WCBox.h>
 #include <images/Regions/ImageRegion.h>
+#include <lattices/Lattices/ArrayLattice.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Arrays/ArrayMath.h>
 
 using namespace casacore;
 using namespace casa;
@@ -67,6 +70,49 @@ void SDMaskHandlerTest::generateBoxMaskImage(String imagename, Int imsize, Int n
     } 
 }
 
+// region labelling by the recursive depth-first search that labelRegions
+// used before, as the reference for its numbering
+static void referenceSearch(Int x, Int y, Int cur_label, Lattice<Float>& inlat, Lattice<Float>& lablat)
+{
+    IPosition inshape = inlat.shape();
+    if (x < 0 || x == inshape(0)) return;
+    if (y < 0 || y == inshape(1)) return;
+    IPosition loc(inshape.nelements(), 0);
+    loc(0) = x;
+    loc(1) = y;
+    // already labelled or not value 1 pixel
+    if (lablat(loc) || !inlat(loc)) return;
+    lablat.putAt(Float(cur_label), loc);
+    referenceSearch(x + 1, y, cur_label, inlat, lablat);
+    referenceSearch(x, y + 1, cur_label, inlat, lablat);
+    referenceSearch(x - 1, y, cur_label, inlat, lablat);
+    referenceSearch(x, y - 1, cur_label, inlat, lablat);
+}
+
+static void referenceLabels(Lattice<Float>& inlat, Lattice<Float>& lablat)
+{
+    Int blobId = 0;
+    IPosition inshape = inlat.shape();
+    IPosition loc(inshape.nelements(), 0);
+    for (Int i = 0; i < inshape(0); ++i) {
+      for (Int j = 0; j < inshape(1); ++j) {
+        loc(0) = i;
+        loc(1) = j;
+        if (!lablat(loc) && inlat(loc)) referenceSearch(i, j, ++blobId, inlat, lablat);
+      }
+    }
+}
+
+// pixels set to 1 with a fixed pseudo-random sequence, about half of them
+static void randomMask(Array<Float>& arr)
+{
+    uInt seed = 12345;
+    for (Array<Float>::iterator it = arr.begin(); it != arr.end(); ++it) {
+      seed = seed*1103515245 + 12345;
+      *it = ((seed >> 16) & 1) ? 1.0 : 0.0;
+    }
+}
+
 ImageInterfaceTest::ImageInterfaceTest() {}
 ImageInterfaceTest::~ImageInterfaceTest() {}
 
@@ -458,6 +504,150 @@ void ImageInterfaceTest::testYAPruneRegions()
     SHARED_PTR<ImageInterface<Float> > tempIm_ptr = maskhandler.YAPruneRegions(InImage,prunesize);
     PagedImage<Float> outMask(InImage.shape(), InImage.coordinates(), "testYAPruneRegions-out.mask");
     outMask.copyData(*(tempIm_ptr.get()) );
+    //chan0: single pixels are removed, the 5-pixel region is kept
+    ASSERT_TRUE(outMask.getAt(IPosition(4,40,50,0,0))==Float(0.0));
+    ASSERT_TRUE(outMask.getAt(IPosition(4,0,0,0,0))==Float(0.0));
+    ASSERT_TRUE(outMask.getAt(IPosition(4,99,99,0,0))==Float(0.0));
+    ASSERT_TRUE(outMask.getAt(IPosition(4,44,54,0,0))==Float(0.0));
+    ASSERT_TRUE(outMask.getAt(IPosition(4,45,55,0,0))==Float(1.0));
+    ASSERT_TRUE(outMask.getAt(IPosition(4,47,54,0,0))==Float(1.0));
+    //chan3 and chan4: single pixels are removed
+    ASSERT_TRUE(outMask.getAt(IPosition(4,46,56,0,3))==Float(0.0));
+    ASSERT_TRUE(outMask.getAt(IPosition(4,45,56,0,4))==Float(0.0));
+    ASSERT_TRUE(sum(outMask.get())==Float(5.0));
+
+    // each channel is pruned as a single plane would be
+    InImage.set(0.0);
+    Array<Float> planes(shape);
+    randomMask(planes);
+    InImage.put(planes);
+    prunesize=4.0;
+    tempIm_ptr = maskhandler.YAPruneRegions(InImage,prunesize);
+    for (Int ich=0; ich < shape(3); ich++) {
+      IPosition planeShape(2, shape(0), shape(1));
+      ArrayLattice<Float> inplane(planes(IPosition(4,0,0,0,ich), IPosition(4,shape(0)-1,shape(1)-1,0,ich)).nonDegenerate().copy());
+      ArrayLattice<Float> labels(planeShape);
+      labels.set(0.0);
+      referenceLabels(inplane, labels);
+      Array<Float> expected = inplane.get().copy();
+      Vector<Float> blobsizes = maskhandler.findBlobSize(labels);
+      Array<Float> labelData = labels.get();
+      Array<Float>::const_iterator lab = labelData.begin();
+      for (Array<Float>::iterator it = expected.begin(); it != expected.end(); ++it, ++lab) {
+        if (*lab > 0 && blobsizes[Int(*lab)-1] < prunesize) *it = 0.0;
+      }
+      Array<Float> pruned = tempIm_ptr->getSlice(IPosition(4,0,0,0,ich), IPosition(4,shape(0),shape(1),1,1)).reform(planeShape);
+      ASSERT_TRUE(allEQ(pruned, expected));
+    }
+}
+
+void ImageInterfaceTest::testLabelRegions()
+{
+    cout <<" Test labelRegions()"<<endl;
+    SDMaskHandler maskhandler;
+
+    // U-shaped islands, whose arms only meet late along the second axis,
+    // and one whose arms are met in the opposite order
+    IPosition shape(2, 12, 10);
+    ArrayLattice<Float> inlat(shape);
+    inlat.set(0.0);
+    for (Int j = 1; j < 9; j++) {
+      inlat.putAt(1.0, IPosition(2,1,j));
+      inlat.putAt(1.0, IPosition(2,4,j));
+      inlat.putAt(1.0, IPosition(2,7,j+1));
+      inlat.putAt(1.0, IPosition(2,10,j+1));
+    }
+    for (Int i = 1; i < 5; i++) inlat.putAt(1.0, IPosition(2,i,8));
+    for (Int i = 7; i < 11; i++) inlat.putAt(1.0, IPosition(2,i,1));
+    inlat.putAt(1.0, IPosition(2,2,3));
+    inlat.putAt(1.0, IPosition(2,11,0));
+    ArrayLattice<Float> labels(shape);
+    ArrayLattice<Float> expected(shape);
+    labels.set(0.0);
+    expected.set(0.0);
+    maskhandler.labelRegions(inlat, labels);
+    referenceLabels(inlat, expected);
+    ASSERT_TRUE(allEQ(labels.get(), expected.get()));
+    ASSERT_TRUE(max(labels.get())==Float(3.0));
+
+    // a large random pattern, with many merges
+    IPosition bigShape(2, 97, 83);
+    ArrayLattice<Float> bigIn(bigShape);
+    Array<Float> bigData(bigShape);
+    randomMask(bigData);
+    bigIn.put(bigData);
+    ArrayLattice<Float> bigLabels(bigShape);
+    ArrayLattice<Float> bigExpected(bigShape);
+    bigLabels.set(0.0);
+    bigExpected.set(0.0);
+    maskhandler.labelRegions(bigIn, bigLabels);
+    referenceLabels(bigIn, bigExpected);
+    ASSERT_TRUE(allEQ(bigLabels.get(), bigExpected.get()));
+
+    // pixels labelled already are kept, and split the islands they are in
+    labels.set(0.0);
+    expected.set(0.0);
+    labels.putAt(9.0, IPosition(2,4,5));
+    labels.putAt(9.0, IPosition(2,8,1));
+    expected.putAt(9.0, IPosition(2,4,5));
+    expected.putAt(9.0, IPosition(2,8,1));
+    maskhandler.labelRegions(inlat, labels);
+    referenceLabels(inlat, expected);
+    ASSERT_TRUE(allEQ(labels.get(), expected.get()));
+    ASSERT_TRUE(labels.getAt(IPosition(2,4,5))==Float(9.0));
+
+    // 3-D and 4-D input: only the first plane is labelled
+    IPosition shape3(3, 12, 10, 2);
+    ArrayLattice<Float> inlat3(shape3);
+    Array<Float> data3(shape3);
+    randomMask(data3);
+    inlat3.put(data3);
+    ArrayLattice<Float> labels3(shape3);
+    ArrayLattice<Float> expected3(shape3);
+    labels3.set(0.0);
+    expected3.set(0.0);
+    maskhandler.labelRegions(inlat3, labels3);
+    referenceLabels(inlat3, expected3);
+    ASSERT_TRUE(allEQ(labels3.get(), expected3.get()));
+    ASSERT_TRUE(allEQ(labels3.getSlice(IPosition(3,0,0,1), IPosition(3,12,10,1)), Float(0.0)));
+
+    IPosition shape4(4, 12, 10, 1, 3);
+    ArrayLattice<Float> inlat4(shape4);
+    Array<Float> data4(shape4);
+    randomMask(data4);
+    inlat4.put(data4);
+    ArrayLattice<Float> labels4(shape4);
+    ArrayLattice<Float> expected4(shape4);
+    labels4.set(0.0);
+    expected4.set(0.0);
+    maskhandler.labelRegions(inlat4, labels4);
+    referenceLabels(inlat4, expected4);
+    ASSERT_TRUE(allEQ(labels4.get(), expected4.get()));
+    ASSERT_TRUE(allEQ(labels4.getSlice(IPosition(4,0,0,0,1), IPosition(4,12,10,1,2)), Float(0.0)));
+}
+
+void ImageInterfaceTest::testFindBlobSize()
+{
+    cout <<" Test findBlobSize()"<<endl;
+    SDMaskHandler maskhandler;
+    IPosition shape(4, 6, 5, 1, 2);
+    ArrayLattice<Float> labels(shape);
+    labels.set(0.0);
+    // no regions
+    ASSERT_TRUE(maskhandler.findBlobSize(labels).nelements()==0);
+    labels.putAt(1.0, IPosition(4,0,0,0,0));
+    labels.putAt(1.0, IPosition(4,1,0,0,0));
+    labels.putAt(2.0, IPosition(4,5,4,0,0));
+    labels.putAt(3.0, IPosition(4,3,2,0,0));
+    labels.putAt(3.0, IPosition(4,3,3,0,0));
+    labels.putAt(3.0, IPosition(4,4,3,0,0));
+    // only the first plane counts
+    labels.putAt(4.0, IPosition(4,2,2,0,1));
+    Vector<Float> blobsizes = maskhandler.findBlobSize(labels);
+    ASSERT_TRUE(blobsizes.nelements()==3);
+    ASSERT_TRUE(blobsizes[0]==Float(2.0));
+    ASSERT_TRUE(blobsizes[1]==Float(1.0));
+    ASSERT_TRUE(blobsizes[2]==Float(3.0));
 }
 
 
@@ -515,6 +705,14 @@ TEST_F(ImageInterfaceTest, testYAPruneRegions) {
   testYAPruneRegions();
 }
 
+TEST_F(ImageInterfaceTest, testLabelRegions) {
+  testLabelRegions();
+}
+
+TEST_F(ImageInterfaceTest, testFindBlobSize) {
+  testFindBlobSize();
+}
+
 }//test
 
 int main(int argc, char **argv) {
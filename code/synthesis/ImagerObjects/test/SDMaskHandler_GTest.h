@@ -66,6 +66,8 @@ protected:
      void testBinaryDilation();
      void testBinaryDilationIter();
      void testYAPruneRegions();
+     void testLabelRegions();
+     void testFindBlobSize();
 
 };
 
@@ -40,6 +40,7 @@
 #include <casa/BasicSL/String.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/OS/HostInfo.h>
+#include <memory>
 
 #include <casa/sstream.h>
 #include <casa/Logging/LogMessage.h>
@@ -54,6 +55,21 @@
 using namespace casacore;
 namespace casa { //# NAMESPACE CASA - BEGIN
 
+// Make a scratch lattice for a slice of the image.  Worker threads keep
+// theirs in memory, as the table system behind a PagedArray is shared by
+// the whole process.
+static Lattice<Float> *makeScratch(const IPosition &shape, Int cache)
+{
+  Lattice<Float> *scratch;
+  if (applicator.isThreaded()) {
+    scratch = new ArrayLattice<Float>(shape);
+  } else {
+    scratch = new PagedArray<Float>(TiledShape(shape));
+  }
+  scratch->setMaximumCacheSize(cache);
+  return scratch;
+}
+
 ClarkCleanAlgorithm::ClarkCleanAlgorithm() : model_sl_p(0), 
   myName("Clark Clean")
 {
@@ -83,9 +99,8 @@ void ClarkCleanAlgorithm::get()
   applicator.get(chan);
   applicator.get(nchan);
   if (model_sl_p) delete model_sl_p;
-  model_sl_p = new PagedArray<Float>(TiledShape(residual_sl.shape()));
+  model_sl_p = makeScratch(residual_sl.shape(), cache_p);
   model_sl_p->set(0.0f);
-  model_sl_p->setMaximumCacheSize(cache_p);
 }
 
 void ClarkCleanAlgorithm::put() 
@@ -102,18 +117,23 @@ String& ClarkCleanAlgorithm::name()
 return myName;
 };
 
+Algorithm *ClarkCleanAlgorithm::clone() const
+{
+// Return a new instance for a worker thread
+//
+  return new ClarkCleanAlgorithm;
+}
+
 void ClarkCleanAlgorithm::task()
 {
 // Do the parallelized part of the Clark CLEAN, acting on
 // the local data obtained from the controller.
 //
   LogIO os(LogOrigin("task","solve in parallel",WHERE));
-  PagedArray<Float> dirty_sl(TiledShape(residual_sl.shape()));
-  dirty_sl.setMaximumCacheSize(cache_p);
-  dirty_sl.put(residual_sl);
-  PagedArray<Float> resid_sl(TiledShape(residual_sl.shape()));
-  resid_sl.setMaximumCacheSize(cache_p);
-  resid_sl.put(residual_sl);
+  std::unique_ptr<Lattice<Float> > dirty_sl(makeScratch(residual_sl.shape(), cache_p));
+  dirty_sl->put(residual_sl);
+  std::unique_ptr<Lattice<Float> > resid_sl(makeScratch(residual_sl.shape(), cache_p));
+  resid_sl->put(residual_sl);
 
   ArrayLattice<Float> al_psf_sl(psf_sf);
   Float psfmax;
@@ -127,7 +147,7 @@ void ClarkCleanAlgorithm::task()
   if(psfmax==0.0) {
     os << "No data for this channel: skipping" << LogIO::POST;
   } else {
-    LatConvEquation eqn(al_psf_sl, dirty_sl);
+    LatConvEquation eqn(al_psf_sl, *dirty_sl);
     ClarkCleanLatModel cleaner(*model_sl_p);
     ArrayLattice<Float> latMask(mask);
     if (mask.nelements() > 1) {
@@ -147,7 +167,7 @@ void ClarkCleanAlgorithm::task()
        << " to get to a max residual of " << cleaner.threshold() 
        << LogIO::POST;
     // cleaner.getModel(image);
-    eqn.residual(resid_sl, cleaner);
+    eqn.residual(*resid_sl, cleaner);
   }
 };
 
@@ -51,9 +51,15 @@ class ClarkCleanAlgorithm : public Algorithm {
   // Return the name of the algorithm
   casacore::String &name();
 
+  // Safe on worker threads: the scratch lattices are then kept in memory
+  casacore::Bool threadSafe() const {return true;};
+
+  // Return a new instance for a worker thread
+  Algorithm *clone() const;
+
  private:
   // Local copies of the data and input parameters
-  casacore::PagedArray<casacore::Float> *model_sl_p;
+  casacore::Lattice<casacore::Float> *model_sl_p;
   casacore::Array<casacore::Float>      residual_sl;
   casacore::Array<casacore::Float>      psf_sf;
   casacore::Array<casacore::Float>      mask;
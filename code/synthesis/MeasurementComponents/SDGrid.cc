@@ -78,6 +78,10 @@
 #include <synthesis/TransformMachines/SkyJones.h>
 #include <synthesis/TransformMachines/StokesImageUtil.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace casacore;
 namespace casa {
 
@@ -991,30 +995,71 @@ void SDGrid::put(const VisBuffer& vb, Int row, Bool dopsf,
 
       Bool call_ggridsd = !clipminmax_ || dopsf;
 
+      // The grid channels are distributed over the threads in
+      // contiguous blocks. Each thread gets a copy of the channel map
+      // in which channels outside its block are unmapped, so it only
+      // writes to its own planes of the grids and columns of
+      // sumWeight. The pixel and weight lookup of a row is done once
+      // per row by the gridder and reused for all channels of the
+      // block.
+      Int nth=1;
+#ifdef _OPENMP
+      if(numthreads_p >0){
+	nth=min(numthreads_p, omp_get_max_threads());
+      }
+      else{
+	nth=omp_get_max_threads();
+      }
+#endif
+      nth=max(1, min(nth, nchan));
+      Block<Vector<Int> > blockChanMap(nth);
+      Block<Int *> cmapStor(nth);
+      for (Int ith=0; ith<nth; ++ith) {
+	Int chanBeg=(nchan*ith)/nth;
+	Int chanEnd=(nchan*(ith+1))/nth;
+	blockChanMap[ith].resize(chanMap.nelements());
+	for (uInt ichan=0; ichan<chanMap.nelements(); ++ichan) {
+	  blockChanMap[ith](ichan)=(chanMap(ichan)>=chanBeg && chanMap(ichan)<chanEnd) ? chanMap(ichan) : -1;
+	}
+	cmapStor[ith]=blockChanMap[ith].getStorage(del);
+      }
+
+      Double *xyStor=xyPositions.getStorage(del);
+      const Int *flagStor=flags.getStorage(del);
+      const Int *rowFlagStor=rowFlags.getStorage(del);
+      Float *convStor=convFunc.getStorage(del);
+      Int *pmapStor=polMap.getStorage(del);
+      Double *sumWtStor=sumWeight.getStorage(del);
+
       if (call_ggridsd) {
 
-      ggridsd(xyPositions.getStorage(del),
-	      datStorage,
-	      &s[0],
-	      &s[1],
-	      &idopsf,
-	      flags.getStorage(del),
-	      rowFlags.getStorage(del),
-	      wgtStorage,
-	      &s[2],
-	      &row,
-	      datStor,
-	      wgtStor,
-	      &nx,
-	      &ny,
-	      &npol,
-	      &nchan,
-	      &convSupport,
-	      &convSampling,
-	      convFunc.getStorage(del),
-	      chanMap.getStorage(del),
-	      polMap.getStorage(del),
-	      sumWeight.getStorage(del));
+#pragma omp parallel for num_threads(nth)
+      for (Int ith=0; ith<nth; ++ith) {
+	// the gridder uses the row argument as its loop variable
+	Int irow=row;
+	ggridsd(xyStor,
+		datStorage,
+		&s[0],
+		&s[1],
+		&idopsf,
+		flagStor,
+		rowFlagStor,
+		wgtStorage,
+		&s[2],
+		&irow,
+		datStor,
+		wgtStor,
+		&nx,
+		&ny,
+		&npol,
+		&nchan,
+		&convSupport,
+		&convSampling,
+		convStor,
+		cmapStor[ith],
+		pmapStor,
+		sumWtStor);
+      }
 
       } else {
         Bool gminCopy;
@@ -1027,33 +1072,37 @@ void SDGrid::put(const VisBuffer& vb, Int row, Bool dopsf,
         Float *wmaxStor = wmax_.getStorage(wmaxCopy);
         Bool npCopy;
         Int *npStor = npoints_.getStorage(npCopy);
-        
-        ggridsdclip(xyPositions.getStorage(del),
-          datStorage,
-          &s[0],
-          &s[1],
-          flags.getStorage(del),
-          rowFlags.getStorage(del),
-          wgtStorage,
-          &s[2],
-          &row,
-          datStor,
-          wgtStor,
-          npStor,
-          gminStor,
-          wminStor,
-          gmaxStor,
-          wmaxStor,
-          &nx,
-          &ny,
-          &npol,
-          &nchan,
-          &convSupport,
-          &convSampling,
-          convFunc.getStorage(del),
-          chanMap.getStorage(del),
-          polMap.getStorage(del),
-          sumWeight.getStorage(del));
+
+#pragma omp parallel for num_threads(nth)
+        for (Int ith=0; ith<nth; ++ith) {
+          Int irow=row;
+          ggridsdclip(xyStor,
+            datStorage,
+            &s[0],
+            &s[1],
+            flagStor,
+            rowFlagStor,
+            wgtStorage,
+            &s[2],
+            &irow,
+            datStor,
+            wgtStor,
+            npStor,
+            gminStor,
+            wminStor,
+            gmaxStor,
+            wmaxStor,
+            &nx,
+            &ny,
+            &npol,
+            &nchan,
+            &convSupport,
+            &convSampling,
+            convStor,
+            cmapStor[ith],
+            pmapStor,
+            sumWtStor);
+        }
 
         gmin_.putStorage(gminStor, gminCopy);
         gmax_.putStorage(gmaxStor, gmaxCopy);
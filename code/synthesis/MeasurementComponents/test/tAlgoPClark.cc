@@ -56,7 +56,7 @@
 #include <casa/namespace.h>
 extern casa::Applicator casa::applicator;
 
-void master(Int argc, Char *argv[]);
+Bool master(Input &inputs);
 
    // Main routine call master to set the problem up and then the 
    // slaves to do the work.
@@ -64,10 +64,26 @@ void master(Int argc, Char *argv[]);
 int main(Int argc, Char *argv[]){
 
    LogIO os(LogOrigin("tPClark","master solve in parallel",WHERE));
-   casa::applicator.init(argc, argv);
+   Input inputs(1);
+   inputs.create("ImageTable", "image.tab", "Input image table name");
+   inputs.create("PSFTable", "psf.tab", "Input psf table name");
+   inputs.create("ModelTable", "cleaned.tab", "Output model table name");
+   inputs.create("Iters", "100", "Number of iterations", "Int");
+   inputs.create("Threshold", "0.2", "Clean Threshold", "Float");
+   inputs.create("Gain", "0.2", "Clean Gain", "Float");
+   inputs.create("Threads", "0", "Number of worker threads (0: aipsrc/MPI)", "Int");
+   inputs.create("Reference", "", "Model table of an earlier (serial) run to compare with");
+   inputs.readArguments(argc, argv);
+
+   Int nThreads = inputs.getInt("Threads");
+   if (nThreads > 0) {
+      casa::applicator.init(argc, argv, nThreads);
+   } else {
+      casa::applicator.init(argc, argv);
+   }
    if(casa::applicator.isController()){
       try {
-         master(argc, argv);
+         return master(inputs) ? 0 : 1;
        }
        catch(AipsError x){
          cerr << "AipsError thrown : " << x.getMesg() << endl;
@@ -76,23 +92,11 @@ int main(Int argc, Char *argv[]){
    return(1);
 }
 
-  // Master setups up the clean;
-void master(Int argc, Char *argv[]) {
+  // Master setups up the clean; returns false if the model does not
+  // match the reference one
+Bool master(Input &inputs) {
    // this corresponds to the solve function for the ClarkCleanImageSkyModel
 
-   // Input stuff is only needed for rank 0 so do the MPI_Init stuff
-   // then split it up into master slave.
-
-
-   Input inputs(1);
-   inputs.create("ImageTable", "image.tab", "Input image table name");
-   inputs.create("PSFTable", "psf.tab", "Input psf table name");
-   inputs.create("ModelTable", "cleaned.tab", "Output model table name");
-   inputs.create("Iters", "100", "Number of iterations", "Int");
-   inputs.create("Threshold", "0.2", "Clean Threshold", "Float");
-   inputs.create("Gain", "0.2", "Clean Gain", "Float");
-   inputs.readArguments(argc, argv);
-
    String ImageTable = inputs.getString("ImageTable");
    String PSFTable = inputs.getString("PSFTable");
    String ModelTable = inputs.getString("ModelTable");
@@ -237,5 +241,21 @@ void master(Int argc, Char *argv[]) {
     rank = casa::applicator.nextProcessDone(clarkClean, allDone);
   };
 
-  return;
+  // The channels are cleaned independently, so however they were
+  // farmed out the model should match that of the reference run
+  String Reference = inputs.getString("Reference");
+  if (Reference != "") {
+    PagedImage<Float> reference(Reference);
+    if (!reference.shape().isEqual(image.shape())) {
+      cerr << "Model shape differs from the reference one" << endl;
+      return false;
+    }
+    Float diff = max(abs(image.get() - reference.get()));
+    if (diff > 1.0e-5*max(1.0f, max(abs(reference.get())))) {
+      cerr << "Model differs from the reference one by " << diff << endl;
+      return false;
+    }
+    cout << "Model matches the reference one" << endl;
+  }
+  return true;
 }
@@ -32,6 +32,7 @@
 
 //# Includes
 #include <synthesis/Parallel/Applicator.h>
+#include <casa/Exceptions/Error.h>
 
 namespace casacore{
 
@@ -108,6 +109,17 @@ class Algorithm {
   // Return the name of the algorithm
   virtual casacore::String &name() = 0;
 
+  // true if instances of this algorithm may run concurrently on the
+  // worker threads of a ThreadTransport.  The Applicator has the
+  // controller run the tasks of other algorithms itself.
+  virtual casacore::Bool threadSafe() const {return false;};
+
+  // Return a new instance of this algorithm; each worker thread of a
+  // ThreadTransport executes its own.  Needed only if threadSafe().
+  virtual Algorithm *clone() const {
+    throw(casacore::AipsError("Parallel algorithm cannot be cloned for a worker thread"));
+  };
+
  protected:
   // Do the work assigned as a parallel task
   virtual void task() = 0;
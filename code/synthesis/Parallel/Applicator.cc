@@ -35,6 +35,8 @@
 #include <synthesis/MeasurementComponents/ResidualAlgorithm.h>
 #include <casa/BasicMath/Math.h>
 #include <synthesis/Parallel/MPIError.h>
+#include <casa/System/AipsrcValue.h>
+#include <casa/sstream.h>
 #ifdef PABLO_IO
 #include <synthesis/Parallel/PabloIO.h>
 #endif
@@ -42,9 +44,13 @@
 using namespace casacore;
 namespace casa { //# NAMESPACE CASA - BEGIN
 
+// Set once the calling worker thread has signalled done for its task
+static thread_local Bool taskDone(false);
+
 Applicator::Applicator() : comm(0), algorithmIds(0),
   knownAlgorithms((Algorithm*)0), LastID(101), usedAllThreads(false),
-  serial(true), nProcs(0), procStatus(0)
+  serial(true), threaded(false), controllerAssigned(false), nProcs(0),
+  procStatus(0)
 {
 // Default constructor; requires later init().
 }
@@ -97,12 +103,29 @@ void Applicator::initThreads(Int /*argc*/, Char */*argv*/[]){
   return;
 }
 
-   // Serial transport all around.
+   // Serial transport all around, unless worker threads are asked for.
 void Applicator::initThreads(){
+  Int nThreads;
+  AipsrcValue<Int>::find(nThreads, "synthesis.applicator.nthreads", 0);
+  initThreads(nThreads);
+  return;
+}
+
+void Applicator::initThreads(Int nThreads){
+  if (nThreads > 0) {
+     // Initialize a shared memory transport layer; the workers are
+     // started once comm is set, as their loop() uses it.
+    ThreadTransport *threads = new ThreadTransport(nThreads);
+    comm = threads;
+    threaded = true;
+    setupProcStatus();
+    threads->start([this]() {loop();});
+  } else {
      // Initialize a serial transport layer
-  comm = new SerialTransport();
+    comm = new SerialTransport();
      // Initialize the process status list
-  setupProcStatus();
+    setupProcStatus();
+  }
   return;
 }
 
@@ -124,6 +147,16 @@ void Applicator::init(Int /*argc*/, Char */*argv*/[])
   return;
 }
 
+void Applicator::init(Int /*argc*/, Char */*argv*/[], Int nThreads)
+{
+// Initialize with the given number of worker threads, whatever aipsrc
+// says and whether or not MPI is available
+//
+  defineAlgorithms();
+  initThreads(nThreads);
+  return;
+}
+
 Bool Applicator::isController()
 {
 // Return T if the current process is the controller
@@ -156,10 +189,15 @@ void Applicator::loop()
 //
   Bool die(false);
   Int what;
+  // Worker threads execute their own instances of the algorithms
+  std::map<Int, std::unique_ptr<Algorithm> > localAlgorithms;
   // Wait for a message from the controller with any Algorithm tag
   while(!die){
-    comm->connectToController();
-    comm->setAnyTag();
+    // The connection is shared by all threads; theirs is implicit
+    if (!threaded) {
+      comm->connectToController();
+      comm->setAnyTag();
+    }
     comm->get(what);
     switch(what){
     case STOP :
@@ -168,7 +206,22 @@ void Applicator::loop()
     default :
       // In this case, an Algorithm tag is expected.
       // First check that it is known.
-      if (knownAlgorithms.isDefined(what)) {
+      if (threaded) {
+	// An exception must not end the thread (and the process): it is
+	// passed on to the controller instead.
+	taskDone = false;
+	try {
+	  Algorithm *a = localAlgorithm(what, localAlgorithms);
+	  if (!a) {
+	    throw(AipsError("Unidentified parallel algorithm code"));
+	  }
+	  a->apply();
+	} catch (std::exception &x) {
+	  failTask(x.what());
+	} catch (...) {
+	  failTask("Unknown exception");
+	}
+      } else if (knownAlgorithms.isDefined(what)) {
 	// Identified algorithm tag; set for subsequent communication
 	comm->setTag(what);
 	// Execute (apply) the algorithm
@@ -182,6 +235,39 @@ void Applicator::loop()
   return;
 }
 
+Algorithm *Applicator::localAlgorithm(Int what,
+				      std::map<Int, std::unique_ptr<Algorithm> > &local)
+{
+// Return the calling worker thread's instance of an Algorithm, made on
+// first use; 0 if the algorithm tag is not known
+//
+  if (local.find(what) == local.end()) {
+    std::lock_guard<std::mutex> guard(algorithmLock);
+    if (!knownAlgorithms.isDefined(what)) {
+      return 0;
+    }
+    local[what].reset(knownAlgorithms(what)->clone());
+  }
+  return local[what].get();
+}
+
+void Applicator::failTask(const String &message)
+{
+// Report the failure of the calling worker thread's task to the controller
+//
+  ThreadTransport *threads = static_cast<ThreadTransport *>(comm);
+  ostringstream oss;
+  oss << "Parallel task failed on worker thread " << threads->cpu()
+      << ": " << message;
+  threads->fail(String(oss));
+  // Until done is signalled the controller may still be sending the
+  // task's input; it resyncs the channel in nextProcessDone().
+  if (!taskDone) {
+    threads->awaitResync();
+  }
+  return;
+}
+
 Bool Applicator::nextAvailProcess(Algorithm &a, Int &rank)
 {
 // Assign the next available process for the specified Algorithm
@@ -190,6 +276,18 @@ Bool Applicator::nextAvailProcess(Algorithm &a, Int &rank)
   Bool assigned;
   if (isWorker()) {
     throw(AipsError("Must be the controller to assign a worker process"));
+  } else if (threaded && !a.threadSafe()) {
+    // The controller runs the task itself, as in the serial case, once
+    // the results of its previous one have been collected; there is no
+    // worker loop to send the algorithm tag to.
+    if (!controllerAssigned) {
+      rank = comm->controllerRank();
+      comm->connect(rank);
+      controllerAssigned = true;
+      assigned = true;
+    } else {
+      assigned = false;
+    }
   } else {
     if (!usedAllThreads) {
       // Connect to the next available process in the list
@@ -219,6 +317,21 @@ Int Applicator::nextProcessDone(Algorithm &a, Bool &allDone)
 //
   Int rank = -1;
   allDone = true;
+  if (threaded && !a.threadSafe()) {
+    // The task, if any, was run by the controller in apply()
+    if (controllerAssigned) {
+      rank = comm->controllerRank();
+      comm->connect(rank);
+      Int doneSignal;
+      get(doneSignal);
+      controllerAssigned = false;
+      if (doneSignal != DONE) {
+	throw(AipsError("Parallel task ended unexpectedly on the controller"));
+      }
+      allDone = false;
+    }
+    return rank;
+  }
   for (uInt i=0; i<procStatus.nelements(); i++) {
     if (procStatus(i) == ASSIGNED) {
       if (isSerial()) {
@@ -238,7 +351,19 @@ Int Applicator::nextProcessDone(Algorithm &a, Bool &allDone)
     Int tag = algorithmIds(a.name());
     comm->setTag(tag);
     Int doneSignal;
-    rank = get(doneSignal);
+    try {
+      rank = get(doneSignal);
+    } catch (AipsError &) {
+      if (!threaded) throw;
+      // The worker's task failed (see loop()); free the worker, let it
+      // drop the input it has not read, and pass the error on.
+      ThreadTransport *threads = static_cast<ThreadTransport *>(comm);
+      rank = threads->connection();
+      procStatus(rank) = FREE;
+      usedAllThreads = false;
+      threads->resync(rank);
+      throw;
+    }
     // Consistency check; should return a DONE signal to contoller
     // on completion.
     if (doneSignal != DONE) {
@@ -258,6 +383,7 @@ void Applicator::done()
 {
 // Signal that a worker process is done
 //
+  taskDone = true;
   put(DONE);
   return;
 }
@@ -272,12 +398,23 @@ void Applicator::apply(Algorithm &a)
   // performed in workers processes' applicator.init().
   if (isSerial() && isController()) {
     a.apply();
+  } else if (threaded && !a.threadSafe() && isController()) {
+    // Not for the worker threads; the controller runs it, and what it
+    // left unread or unsent is dropped if it fails
+    try {
+      a.apply();
+    } catch (...) {
+      static_cast<ThreadTransport *>(comm)->clearLoopback();
+      controllerAssigned = false;
+      throw;
+    }
   }
   return;
 }
 
 void Applicator::defineAlgorithm(Algorithm *a)
 {
+   std::lock_guard<std::mutex> guard(algorithmLock);
    knownAlgorithms.define(LastID, a);
    algorithmIds.define(a->name(), LastID);
    LastID++;
@@ -37,6 +37,9 @@
 #include <casa/Containers/OrderedMap.h>
 #include <casa/Containers/Record.h>
 #include <synthesis/Parallel/PTransport.h>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -65,6 +68,14 @@ class Algorithm;
 // The Applicator class provides the interface to parallel communication.
 // It holds the parallel transport layer, and controls the execution of
 // parallelized algorithms.
+// Without MPI the algorithms are executed serially by the controller,
+// unless the aipsrc variable synthesis.applicator.nthreads is set to
+// n > 0, in which case they run on n worker threads (see ThreadTransport).
+// Only algorithms that declare themselves threadSafe() are run on worker
+// threads; the tasks of the others are run by the controller itself, one
+// at a time, when it is given them in apply().  An exception thrown by a task on a worker thread is rethrown
+// to the controller, by nextProcessDone() or by the get() of the task's
+// results.
 // </synopsis>
 //
 // <example>
@@ -101,6 +112,11 @@ class Applicator {
   void init(casacore::Int argc, casacore::Char *argv[]);
   void initThreads(casacore::Int argc, casacore::Char *argv[]);
   void initThreads();
+  void initThreads(casacore::Int nThreads);
+
+  // Initialization with nThreads worker threads (serial if 0), instead
+  // of the transport chosen by MPI availability and aipsrc
+  void init(casacore::Int argc, casacore::Char *argv[], casacore::Int nThreads);
 
   // define an Algorithm if we need too;
   void defineAlgorithm(Algorithm *);
@@ -113,6 +129,9 @@ class Applicator {
   // true if executing serially
   casacore::Bool isSerial() {return serial;};
 
+  // true if the workers are threads of this process
+  casacore::Bool isThreaded() {return threaded;};
+
   // Return the number of processes
   casacore::Int numProcs() {return nProcs;};
 
@@ -174,6 +193,16 @@ class Applicator {
   // true if executing in serial
   casacore::Bool serial;
 
+  // true if the workers are threads of this process
+  casacore::Bool threaded;
+
+  // true while the controller holds the results of a task it ran itself,
+  // for an algorithm that is not thread safe
+  casacore::Bool controllerAssigned;
+
+  // Guards the algorithm maps, which worker threads also read
+  std::mutex algorithmLock;
+
   // Number of processes
   casacore::Int nProcs;
 
@@ -183,6 +212,13 @@ class Applicator {
   // Executed by worker process waiting for an assigned task
   void loop();
 
+  // The instance of an Algorithm a worker thread executes
+  Algorithm *localAlgorithm(casacore::Int what,
+			    std::map<casacore::Int, std::unique_ptr<Algorithm> > &local);
+
+  // Report the failure of a worker thread's task to the controller
+  void failTask(const casacore::String &message);
+
   // Fill algorithm map
   void defineAlgorithms();
 
@@ -32,6 +32,13 @@
 //# Includes
 #include <casa/aips.h>
 #include <casa/Arrays/Array.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace casacore{
 
@@ -88,7 +95,7 @@ class PTransport {
   casacore::Int numThreads() {return numprocs;};
 
   // Return the current process rank
-  casacore::Int cpu() {return myCpu;}
+  virtual casacore::Int cpu() {return myCpu;}
 
   // Set the properties of the current connection including
   // source/destination and message tag.
@@ -334,6 +341,139 @@ class SerialTransport : public PTransport {
   void *getFromQueue();
 };
 
+// <summary>
+// Shared memory data transport model
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="yyyy/mm/dd" tests="" demos="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> PTransport
+//   <li> Applicator
+// </prerequisite>
+//
+// <etymology>
+// Transport between the threads of a single process.
+// </etymology>
+//
+// <synopsis>
+// The workers are threads of the controller process, ranked 1 to n; the
+// thread that made the transport is the controller.  Each worker has a
+// FIFO channel to and from the controller, so messages are matched by
+// order alone and tags are ignored.  Connected to its own rank, the
+// controller sends to and receives from a loopback channel; this is how
+// it runs the tasks the workers must not run.  Nothing is serialised: a
+// message holds its value, and arrays are copied once on put, so the
+// sender may reuse its buffer, and referenced by the receiver on get.
+// </synopsis>
+//
+// <example>
+// </example>
+//
+// <motivation>
+// To run the Applicator's algorithms on all the cores of one machine
+// without MPI.
+// </motivation>
+//
+//
+//# <todo asof="yyyy/mm/dd">
+//# </todo>
+
+class ThreadTransport : public PTransport {
+ public:
+  // Construct for the given number of worker threads
+  ThreadTransport(casacore::Int nWorkers);
+  // Waits for the workers, which must have been told to stop
+  virtual ~ThreadTransport();
+
+  // Start the worker threads, each of which runs workerLoop
+  void start(const std::function<void()> &workerLoop);
+
+  // Rank of the calling thread
+  virtual casacore::Int cpu();
+
+  // Rank of the worker last received from or connected to
+  casacore::Int connection() {return aWorker;};
+
+  // Called by a worker whose task failed.  The controller's next get of
+  // a message from this worker throws an AipsError with the given text.
+  void fail(const casacore::String &message);
+
+  // After the failure of a worker's task the controller calls resync(),
+  // once it has sent all of the task's input, and the worker calls
+  // awaitResync(), which drops whatever input it has not yet read.
+  void resync(casacore::Int rank);
+  void awaitResync();
+
+  // Drop whatever is left in the controller's loopback channel
+  void clearLoopback();
+
+  // Default source and message tag values
+  virtual casacore::Int anyTag() {return -1;};
+  virtual casacore::Int anySource() {return -1;};
+
+  // Define the rank of the controller process
+  virtual casacore::Int controllerRank() {return 0;};
+
+  // Get and put functions on the data transport layer
+  virtual casacore::Int put(const casacore::Array<casacore::Float> &);
+  virtual casacore::Int put(const casacore::Array<casacore::Double> &);
+  virtual casacore::Int put(const casacore::Array<casacore::Complex> &);
+  virtual casacore::Int put(const casacore::Array<casacore::DComplex> &);
+  virtual casacore::Int put(const casacore::Array<casacore::Int> &);
+  virtual casacore::Int put(const casacore::Float &);
+  virtual casacore::Int put(const casacore::Double &);
+  virtual casacore::Int put(const casacore::Complex &);
+  virtual casacore::Int put(const casacore::DComplex &);
+  virtual casacore::Int put(const casacore::Int &);
+  virtual casacore::Int put(const casacore::String &);
+  virtual casacore::Int put(const casacore::Bool &);
+  virtual casacore::Int put(const casacore::Record &);
+
+  virtual casacore::Int get(casacore::Array<casacore::Float> &);
+  virtual casacore::Int get(casacore::Array<casacore::Double> &);
+  virtual casacore::Int get(casacore::Array<casacore::Complex> &);
+  virtual casacore::Int get(casacore::Array<casacore::DComplex> &);
+  virtual casacore::Int get(casacore::Array<casacore::Int> &);
+  virtual casacore::Int get(casacore::Float &);
+  virtual casacore::Int get(casacore::Double &);
+  virtual casacore::Int get(casacore::Complex &);
+  virtual casacore::Int get(casacore::DComplex &);
+  virtual casacore::Int get(casacore::Int &);
+  virtual casacore::Int get(casacore::String &);
+  virtual casacore::Int get(casacore::Bool &);
+  virtual casacore::Int get(casacore::Record &);
+
+  // A message of any type on a channel
+  class Message {
+   public:
+    Message() : seq(0) {}
+    virtual ~Message() {}
+    // Order of arrival at the controller
+    casacore::uLong seq;
+  };
+
+ private:
+  typedef std::deque<std::unique_ptr<Message> > Channel;
+
+  // Channels from the controller to each worker, and back, by rank
+  std::vector<Channel> toWorker;
+  std::vector<Channel> toController;
+  casacore::uLong nextSeq;
+  std::mutex lock;
+  std::condition_variable arrived;
+  std::vector<std::thread> workers;
+
+  // Queue a message from the calling thread
+  casacore::Int add2Queue(Message *);
+  // Wait for the next message to the calling thread; source is set
+  // to the rank of the sender
+  std::unique_ptr<Message> getFromQueue(casacore::Int &source);
+};
+
 
 } //# NAMESPACE CASA - END
 
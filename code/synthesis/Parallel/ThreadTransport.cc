@@ -0,0 +1,312 @@
+//# ThreadTransport.cc: shared memory data transport between threads
+//# Copyright (C) 2017
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+
+#include <synthesis/Parallel/PTransport.h>
+#include <casa/Containers/Record.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/BasicSL/String.h>
+
+using namespace casacore;
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+namespace {
+
+// Rank of the calling thread; the controller keeps the default
+thread_local Int threadRank(0);
+
+template<class T> class Item : public ThreadTransport::Message {
+ public:
+  Item(const T &v) : value(v) {}
+  T value;
+};
+
+// Sent in place of the next message by a worker whose task failed
+class Failure : public ThreadTransport::Message {
+ public:
+  Failure(const String &m) : message(m) {}
+  String message;
+};
+
+// Marks the end of the input of a failed task in a worker's channel
+class Resync : public ThreadTransport::Message {
+};
+
+template<class T> const T &valueOf(const ThreadTransport::Message &m)
+{
+  const Item<T> *item = dynamic_cast<const Item<T> *>(&m);
+  if (!item) {
+    const Failure *failure = dynamic_cast<const Failure *>(&m);
+    if (failure) {
+      throw(AipsError(failure->message));
+    }
+    throw(AipsError("Unexpected data type received on thread transport"));
+  }
+  return item->value;
+}
+
+} // namespace
+
+ThreadTransport::ThreadTransport(Int nWorkers) : PTransport(),
+  toWorker(nWorkers+1), toController(nWorkers+1), nextSeq(0)
+{
+  numprocs = nWorkers+1;
+  myCpu = controllerRank();
+  aWorker = anySource();
+}
+
+ThreadTransport::~ThreadTransport()
+{
+  for (uInt i=0; i<workers.size(); i++) {
+    workers[i].join();
+  }
+}
+
+void ThreadTransport::start(const std::function<void()> &workerLoop)
+{
+  for (Int rank=1; rank<numprocs; rank++) {
+    workers.push_back(std::thread([rank, workerLoop]() {
+      threadRank = rank;
+      workerLoop();
+    }));
+  }
+}
+
+Int ThreadTransport::cpu()
+{
+  return threadRank;
+}
+
+Int ThreadTransport::add2Queue(Message *item)
+{
+  std::unique_ptr<Message> msg(item);
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (threadRank == controllerRank()) {
+      // Connected to itself, the controller sends to its loopback channel
+      if (aWorker < 0 || aWorker >= numprocs) {
+	throw(AipsError("No worker connected on thread transport"));
+      }
+      toWorker[aWorker].push_back(std::move(msg));
+    } else {
+      msg->seq = nextSeq++;
+      toController[threadRank].push_back(std::move(msg));
+    }
+  }
+  arrived.notify_all();
+  return(0);
+}
+
+std::unique_ptr<ThreadTransport::Message> ThreadTransport::getFromQueue(Int &source)
+{
+  std::unique_lock<std::mutex> guard(lock);
+  Channel *from = 0;
+  if (threadRank != controllerRank()) {
+    source = controllerRank();
+    from = &toWorker[threadRank];
+    arrived.wait(guard, [from]() {return !from->empty();});
+  } else if (aWorker == controllerRank()) {
+    // Nothing else can fill the loopback channel, so don't wait on it
+    source = controllerRank();
+    from = &toWorker[controllerRank()];
+    if (from->empty()) {
+      throw(AipsError("Nothing to receive on the controller's loopback channel"));
+    }
+  } else if (aWorker == anySource()) {
+    // Take the earliest message to have arrived from any worker
+    arrived.wait(guard, [this, &from, &source]() {
+      for (Int i=1; i<numprocs; i++) {
+	if (!toController[i].empty() &&
+	    (!from || toController[i].front()->seq < from->front()->seq)) {
+	  from = &toController[i];
+	  source = i;
+	}
+      }
+      return from != 0;
+    });
+    aWorker = source;
+  } else {
+    source = aWorker;
+    from = &toController[aWorker];
+    arrived.wait(guard, [from]() {return !from->empty();});
+  }
+  std::unique_ptr<Message> msg(std::move(from->front()));
+  from->pop_front();
+  return msg;
+}
+
+void ThreadTransport::fail(const String &message)
+{
+  add2Queue(new Failure(message));
+}
+
+void ThreadTransport::resync(Int rank)
+{
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    toWorker[rank].push_back(std::unique_ptr<Message>(new Resync));
+  }
+  arrived.notify_all();
+}
+
+void ThreadTransport::clearLoopback()
+{
+  std::lock_guard<std::mutex> guard(lock);
+  toWorker[controllerRank()].clear();
+}
+
+void ThreadTransport::awaitResync()
+{
+  Int source;
+  while (!dynamic_cast<Resync *>(getFromQueue(source).get())) {
+  }
+}
+
+Int ThreadTransport::put(const Array<Float> &af){
+   return add2Queue(new Item<Array<Float> >(af.copy()));
+}
+Int ThreadTransport::put(const Array<Double> &af){
+   return add2Queue(new Item<Array<Double> >(af.copy()));
+}
+Int ThreadTransport::put(const Array<Complex> &af){
+   return add2Queue(new Item<Array<Complex> >(af.copy()));
+}
+Int ThreadTransport::put(const Array<DComplex> &af){
+   return add2Queue(new Item<Array<DComplex> >(af.copy()));
+}
+Int ThreadTransport::put(const Array<Int> &af){
+   return add2Queue(new Item<Array<Int> >(af.copy()));
+}
+Int ThreadTransport::put(const Float &f){
+   return add2Queue(new Item<Float>(f));
+}
+Int ThreadTransport::put(const Double &d){
+   return add2Queue(new Item<Double>(d));
+}
+Int ThreadTransport::put(const Complex &f){
+   return add2Queue(new Item<Complex>(f));
+}
+Int ThreadTransport::put(const DComplex &f){
+   return add2Queue(new Item<DComplex>(f));
+}
+Int ThreadTransport::put(const Int &i){
+   return add2Queue(new Item<Int>(i));
+}
+Int ThreadTransport::put(const String &s){
+   return add2Queue(new Item<String>(s));
+}
+Int ThreadTransport::put(const Bool &b){
+   return add2Queue(new Item<Bool>(b));
+}
+Int ThreadTransport::put(const Record &r){
+   return add2Queue(new Item<Record>(r));
+}
+
+// The arrays were copied on put, so the receiver can take a reference
+
+Int ThreadTransport::get(Array<Float> &af){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   af.reference(valueOf<Array<Float> >(*msg));
+   return(source);
+}
+Int ThreadTransport::get(Array<Double> &af){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   af.reference(valueOf<Array<Double> >(*msg));
+   return(source);
+}
+Int ThreadTransport::get(Array<Complex> &af){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   af.reference(valueOf<Array<Complex> >(*msg));
+   return(source);
+}
+Int ThreadTransport::get(Array<DComplex> &af){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   af.reference(valueOf<Array<DComplex> >(*msg));
+   return(source);
+}
+Int ThreadTransport::get(Array<Int> &af){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   af.reference(valueOf<Array<Int> >(*msg));
+   return(source);
+}
+Int ThreadTransport::get(Float &f){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   f = valueOf<Float>(*msg);
+   return(source);
+}
+Int ThreadTransport::get(Double &d){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   d = valueOf<Double>(*msg);
+   return(source);
+}
+Int ThreadTransport::get(Complex &f){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   f = valueOf<Complex>(*msg);
+   return(source);
+}
+Int ThreadTransport::get(DComplex &f){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   f = valueOf<DComplex>(*msg);
+   return(source);
+}
+Int ThreadTransport::get(Int &i){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   i = valueOf<Int>(*msg);
+   return(source);
+}
+Int ThreadTransport::get(String &s){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   s = valueOf<String>(*msg);
+   return(source);
+}
+Int ThreadTransport::get(Bool &b){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   b = valueOf<Bool>(*msg);
+   return(source);
+}
+Int ThreadTransport::get(Record &r){
+   Int source;
+   std::unique_ptr<Message> msg(getFromQueue(source));
+   r = valueOf<Record>(*msg);
+   return(source);
+}
+
+
+} //# NAMESPACE CASA - END
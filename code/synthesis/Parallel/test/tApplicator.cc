@@ -2,137 +2,266 @@
 #include <synthesis/Parallel/Algorithm.h>
 #include <synthesis/Parallel/PTransport.h>
 #include <casa/Arrays/Vector.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
 #include <casa/BasicSL/Complex.h>
 #include <casa/BasicSL/String.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/Utilities/Assert.h>
 #include <casa/iostream.h>
+#include <map>
+#include <set>
+#include <thread>
 
 #include <casa/namespace.h>
 extern casa::Applicator casa::applicator;
 
-class TestAlgorithm : public Algorithm {
-   public :
-      TestAlgorithm() : myName(String("Test Algorithm")){}
-     ~TestAlgorithm(){};
-
-      void get();
-      void put();
-      String &name(){return myName;}
-   private :
-      Int      one;
+// The input of a task, other than its channel
+struct Inputs {
+      Inputs() : two(2.0f), three(3.0), four(4.0,4.0), five(5.0,5.0),
+                 six("Six"), seven(true), aOne(3,1), aTwo(4,2.0f),
+                 aThree(5,3.0), aFour(6,Complex(4.0,4.0)),
+                 aFive(7,DComplex(5.0,5.0)) {}
       Float    two;
       Double   three;
       Complex  four;
       DComplex five;
       String   six;
       Bool     seven;
-      
+
       Vector<Int>      aOne;
       Vector<Float>    aTwo;
       Vector<Double>   aThree;
       Vector<Complex>  aFour;
       Vector<DComplex> aFive;
-      void             task();
-      String           myName;
 };
 
-void TestAlgorithm::get(){
+// The result of a task, both on the workers and in the serial reference
+Double combine(Int chan, const Inputs &in){
+      return chan*(in.two + in.three + real(in.four) + real(in.five) +
+                   sum(in.aOne) + sum(in.aTwo) + sum(in.aThree) +
+                   real(sum(in.aFour)) + real(sum(in.aFive))) +
+             (in.seven ? 1 : 0) + in.six.length();
+}
+
+// A channel of -1 makes get() fail before all the input is read,
+// and one of -2 makes task() fail.
+class TestAlgorithm : public Algorithm {
+   public :
+      TestAlgorithm(const String &name = "Test Algorithm") : myName(name){}
+     ~TestAlgorithm(){};
+
+      void get();
+      void put();
+      String &name(){return myName;}
+      Bool threadSafe() const {return true;}
+      Algorithm *clone() const {return new TestAlgorithm;}
+   private :
+      Int      chan;
+      Inputs   in;
+      Double   result;
+      void     task();
+      String   myName;
+};
 
-      cout << "In TestAlgorithm::get" << endl;
-      casa::applicator.get(one);
-      cout << "got one " << one << endl;
-      casa::applicator.get(two);
-      cout << "got two " << two << endl;
-      casa::applicator.get(three);
-      cout << "got three " << three << endl;
-      casa::applicator.get(four);
-      cout << "got four " << four << endl;
-      casa::applicator.get(five);
-      cout << "got five " << five << endl;
-      casa::applicator.get(six);
-      cout << "got six " << six << endl;
-      casa::applicator.get(seven);
-      cout << "got seven " << seven << endl;
-
-      casa::applicator.get(aOne);
-      cout << "got aOne " << endl;
-      casa::applicator.get(aTwo);
-      cout << "got aTwo " << endl;
-      casa::applicator.get(aThree);
-      cout << "got aThree " << endl;
-      casa::applicator.get(aFour);
-      cout << "got aFour " << endl;
-      casa::applicator.get(aFive);
-      cout << "got aFive " << endl;
+void TestAlgorithm::get(){
+      casa::applicator.get(chan);
+      if (chan == -1) {
+         throw(AipsError("failed in get"));
+      }
+      casa::applicator.get(in.two);
+      casa::applicator.get(in.three);
+      casa::applicator.get(in.four);
+      casa::applicator.get(in.five);
+      casa::applicator.get(in.six);
+      casa::applicator.get(in.seven);
 
+      casa::applicator.get(in.aOne);
+      casa::applicator.get(in.aTwo);
+      casa::applicator.get(in.aThree);
+      casa::applicator.get(in.aFour);
+      casa::applicator.get(in.aFive);
       return;
 }
 
 void TestAlgorithm::put(){
-      casa::applicator.put(true);
+      casa::applicator.put(result);
+      casa::applicator.put(in.aTwo*Float(chan));
       return;
 }
 
 void TestAlgorithm::task(){
-      cout << "Do work now!" << endl;
+      if (chan == -2) {
+         throw(AipsError("failed in task"));
+      }
+      result = combine(chan, in);
       return;
 }
 
+// The same tasks, not declared thread safe, so the controller must run
+// them itself; records the threads that ran them
+class UnsafeAlgorithm : public TestAlgorithm {
+   public :
+      UnsafeAlgorithm() : TestAlgorithm("Unsafe Algorithm"){}
+      void get(){
+         ranOn.insert(std::this_thread::get_id());
+         TestAlgorithm::get();
+      }
+      Bool threadSafe() const {return false;}
+      std::set<std::thread::id> ranOn;
+};
+
+void sendInputs(Int chan, const Inputs &in){
+      casa::applicator.put(chan);
+      casa::applicator.put(in.two);
+      casa::applicator.put(in.three);
+      casa::applicator.put(in.four);
+      casa::applicator.put(in.five);
+      casa::applicator.put(in.six);
+      casa::applicator.put(in.seven);
+
+      casa::applicator.put(in.aOne);
+      casa::applicator.put(in.aTwo);
+      casa::applicator.put(in.aThree);
+      casa::applicator.put(in.aFour);
+      casa::applicator.put(in.aFive);
+}
+
+// Run one task per channel, farming them out as the workers come free
+void runTasks(TestAlgorithm &testMe, const Vector<Int> &chans,
+              std::map<Int, Double> &results,
+              std::map<Int, Vector<Float> > &scaled){
+      Inputs in;
+      std::map<Int, Int> chanNo;
+      Int rank(0);
+      Bool allDone(false);
+      Double result;
+      Array<Float> af;
+      for (uInt i=0; i<chans.nelements(); i++) {
+         Bool assigned = casa::applicator.nextAvailProcess(testMe, rank);
+         while (!assigned) {
+            rank = casa::applicator.nextProcessDone(testMe, allDone);
+            casa::applicator.get(result);
+            casa::applicator.get(af);
+            results[chanNo[rank]] = result;
+            scaled[chanNo[rank]] = af;
+            assigned = casa::applicator.nextAvailProcess(testMe, rank);
+         }
+         sendInputs(chans[i], in);
+         chanNo[rank] = chans[i];
+         casa::applicator.apply(testMe);
+      }
+      rank = casa::applicator.nextProcessDone(testMe, allDone);
+      while (!allDone) {
+         casa::applicator.get(result);
+         casa::applicator.get(af);
+         results[chanNo[rank]] = result;
+         scaled[chanNo[rank]] = af;
+         rank = casa::applicator.nextProcessDone(testMe, allDone);
+      }
+}
+
+// Check the results of the threaded run against the serial evaluation
+void checkResults(const Vector<Int> &chans,
+                  std::map<Int, Double> &results,
+                  std::map<Int, Vector<Float> > &scaled){
+      Inputs in;
+      AlwaysAssertExit(results.size() == chans.nelements());
+      for (uInt i=0; i<chans.nelements(); i++) {
+         AlwaysAssertExit(results[chans[i]] == combine(chans[i], in));
+         AlwaysAssertExit(allEQ(scaled[chans[i]], in.aTwo*Float(chans[i])));
+      }
+}
+
+// Run a single task which should fail with the given message
+void checkFailure(TestAlgorithm &testMe, Int chan, const String &message){
+      Inputs in;
+      Int rank(0);
+      Bool allDone(false);
+      Bool caught(false);
+      AlwaysAssertExit(casa::applicator.nextAvailProcess(testMe, rank));
+      sendInputs(chan, in);
+      casa::applicator.apply(testMe);
+      try {
+         casa::applicator.nextProcessDone(testMe, allDone);
+      } catch (AipsError &x) {
+         caught = x.getMesg().contains(message);
+      }
+      AlwaysAssertExit(caught);
+}
+
 //  OK the test program
 
 int main(Int argc, Char *argv[]){
 
-   TestAlgorithm testMe;
-   casa::applicator.defineAlgorithm(&testMe);
-   casa::applicator.init(argc, argv);
-   if(casa::applicator.isController()){
-      Int rank(1);
-      casa::applicator.nextAvailProcess(testMe, rank);
-
-      Int      one(1);
-      Float    two(2.0f);
-      Double   three(3.0);
-      Complex  four(4.0,4.0);
-      DComplex five(5.0,5.0);
-      String   six("Six");
-      Bool     seven(true);
-      cout << "one " << one << endl;
-      cout << "two " << two << endl;
-      cout << "three " << three << endl;
-      cout << "four " << four << endl;
-      cout << "five " << five << endl;
-      cout << "six " << six << endl;
-      cout << "seven " << seven << endl;
-
-      casa::applicator.put(one);
-      casa::applicator.put(two);
-      casa::applicator.put(three);
-      casa::applicator.put(four);
-      casa::applicator.put(five);
-      casa::applicator.put(six);
-      casa::applicator.put(seven);
-      
-      Vector<Int>      aOne(3,one);
-      Vector<Float>    aTwo(4,two);
-      Vector<Double>   aThree(5,three);
-      Vector<Complex>  aFour(6,four);
-      Vector<DComplex> aFive(7,five);
-
-      casa::applicator.put(aOne);
-      casa::applicator.put(aTwo);
-      casa::applicator.put(aThree);
-      casa::applicator.put(aFour);
-      casa::applicator.put(aFive);
+   try {
+      TestAlgorithm testMe;
+      UnsafeAlgorithm unsafe;
+      casa::applicator.defineAlgorithm(&testMe);
+      casa::applicator.defineAlgorithm(&unsafe);
+      // Run on three worker threads, whatever aipsrc says
+      casa::applicator.init(argc, argv, 3);
+      AlwaysAssertExit(casa::applicator.isController());
+      AlwaysAssertExit(casa::applicator.isThreaded());
+      AlwaysAssertExit(casa::applicator.numProcs() == 4);
 
-      casa::applicator.apply(testMe);
-      Bool status;
-      casa::applicator.get(status);
-/*
-      Bool allDone;
-      applicator.nextProcessDone(testMe, allDone);
-*/
+      Vector<Int> chans(20);
+      indgen(chans);
+      std::map<Int, Double> results;
+      std::map<Int, Vector<Float> > scaled;
+      runTasks(testMe, chans, results, scaled);
+      checkResults(chans, results, scaled);
+      cout << "Threaded results match the serial ones" << endl;
+
+      // A failed task is reported to the controller, and the worker
+      // goes on to the next task
+      checkFailure(testMe, -1, "failed in get");
+      checkFailure(testMe, -2, "failed in task");
+      results.clear();
+      scaled.clear();
+      runTasks(testMe, chans, results, scaled);
+      checkResults(chans, results, scaled);
+      cout << "Failed tasks are reported to the controller" << endl;
+
+      // Algorithms that are not thread safe still complete, on the
+      // controller, and the workers are free again afterwards
+      results.clear();
+      scaled.clear();
+      runTasks(unsafe, chans, results, scaled);
+      checkResults(chans, results, scaled);
+      AlwaysAssertExit(unsafe.ranOn.size() == 1);
+      AlwaysAssertExit(*unsafe.ranOn.begin() == std::this_thread::get_id());
 
-      return 0;
+      // A failure there is thrown by apply(), and the next tasks still run
+      Bool caught(false);
+      try {
+         Inputs in;
+         Int rank(0);
+         Int chan(-2);
+         AlwaysAssertExit(casa::applicator.nextAvailProcess(unsafe, rank));
+         sendInputs(chan, in);
+         casa::applicator.apply(unsafe);
+      } catch (AipsError &x) {
+         caught = x.getMesg().contains("failed in task");
+      }
+      AlwaysAssertExit(caught);
+      Bool allDone(false);
+      casa::applicator.nextProcessDone(unsafe, allDone);
+      AlwaysAssertExit(allDone);
+      results.clear();
+      scaled.clear();
+      runTasks(unsafe, chans, results, scaled);
+      checkResults(chans, results, scaled);
 
+      results.clear();
+      scaled.clear();
+      runTasks(testMe, chans, results, scaled);
+      checkResults(chans, results, scaled);
+      cout << "Algorithms that are not thread safe run on the controller" << endl;
+   } catch (AipsError &x) {
+      cout << "Unexpected exception: " << x.getMesg() << endl;
+      return 1;
    }
+   cout << "OK" << endl;
    return 0;
 }
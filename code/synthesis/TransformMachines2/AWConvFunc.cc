@@ -269,8 +269,23 @@ using namespace casa::vi;
 		cellSize = dc.increment();
 
 		//
-		// Now compute the PS x W-Term and apply the cached
-		// A-Term to build the full CF.
+		// Neither the PS- nor the A-term depend on w.  Make
+		// their product once per frequency and only apply the
+		// W-term in the loop over w-planes below.
+		//
+		Array<Complex> ftATerm(ftATerm_l.get()), psATerm(pbshp);
+		{
+		  Matrix<Complex> psATermMat(psATerm.nonDegenerate());
+		  if (psTerm.isNoOp() || isDryRun)
+		    psATermMat = 1.0;
+		  else
+		    psTerm.applySky(psATermMat, false);   // Assign (psScale set in psTerm.init()
+		}
+		psATerm *= ftATerm;
+
+		//
+		// Now apply the W-Term to the cached PS x A-Term to build
+		// the full CF.
 		//
     		for (uInt iw=0;iw<wValues.nelements();iw++)     // All w-planes
     		  {
@@ -279,67 +294,24 @@ using namespace casa::vi;
 			    << "M:"<<muellerElements(imx)(imy) 
 			    << ",C:" << inu 
 			    << ",W:" << iw << "): ";
-		    // {
-		    //   CountedPtr<CFCell> thisCell=cfb.getCFCellPtr(freqValues(inu), wValues(iw), muellerElements(imx)(imy));
-		    //   thisCell->conjFreq_p = conjFreq;
-		    //   cerr << "ConjFreq: " << thisCell->conjFreq_p << " " << inu << " " << iw << " " << muellerElements(imx)(imy) << endl;
-		    // }
 
     		    Array<Complex> &cfWtBuf=(*(cfWtb.getCFCellPtr(freqValues(inu), wValues(iw), 
 								  muellerElements(imx)(imy))->storage_p));
 		    Array<Complex> &cfBuf=(*(cfb.getCFCellPtr(freqValues(inu), wValues(iw), 
 							      muellerElements(imx)(imy))->storage_p));
-    		    // IPosition cfWtBufShape= cfWtb.getCFCellPtr(freqValues(inu), wValues(iw), 
-		    // 					       muellerElements(imx)(imy))->shape_p;
-		    // IPosition cfBufShape=cfb.getCFCellPtr(freqValues(inu), wValues(iw), 
-		    // 					  muellerElements(imx)(imy))->shape_p;
 		    
-		    cfWtBuf.resize(pbshp);
 		    cfBuf.resize(pbshp);
-
-		    const Vector<Double> sampling_l(2,sampling);
-		    //		    Double wval = wValues[iw];
-		    Matrix<Complex> cfBufMat(cfBuf.nonDegenerate()), 
-		      cfWtBufMat(cfWtBuf.nonDegenerate());
-		    //
-		    // Apply the Prolate Spheroidal and W-Term kernels
-		    //
-
-		    Vector<Double> s(2); s=sampling;
-		    //		    Int inner = cfBufMat.shape()(0)/aTerm.getOversampling();
-		    //		    Float inner = 2.0*aTerm.getOversampling()/cfBufMat.shape()(0);
-
-		    //Timer tim;
-		    //tim.mark();
-		    if (psTerm.isNoOp() || isDryRun)
-		      cfBufMat = cfWtBufMat = 1.0;
-		    else
-		      {
-			psTerm.applySky(cfBufMat, false);   // Assign (psScale set in psTerm.init()
-			psTerm.applySky(cfWtBufMat, false); // Assign
-			cfWtBuf *= cfWtBuf;
-		      }
-		    //tim.show("PSTerm*2: ");
-
-		    // WBAWP CODE BEGIN  -- make PS*PS for Weights
-		    // psTerm.applySky(cfWtBufMat, true);  // Multiply
-		    // WBAWP CODE END
-
-		    // psTerm.applySky(cfBufMat, s, inner/2.0);//pbshp(0)/(os));
-		    // psTerm.applySky(cfWtBufMat, s, inner/2.0);//pbshp(0)/(os));
+		    cfBuf = psATerm;
+		    Matrix<Complex> cfBufMat(cfBuf.nonDegenerate());
 
 		    // W-term is a unit-amplitude term in the image
 		    // doimain.  No need to apply it to the
 		    // wt-functions.
-
-		    //tim.mark();
 		    if (!isDryRun)
 		      {
 			wTerm.applySky(cfBufMat, iw, cellSize, wScale, cfBuf.shape()(0));///4);
 			//cerr << iw << " " << cellSize << " " << iw*iw/wScale << endl;
 		      }
-		    //tim.show("WTerm: ");
-		    // wTerm.applySky(cfWtBufMat, iw, cellSize, wScale, cfWtBuf.shape()(0)/4);
 
     		    IPosition PolnPlane(4,0,0,0,0),
 		      pbShape(4, cfBuf.shape()(0), cfBuf.shape()(1), 1, 1);
@@ -348,91 +320,22 @@ using namespace casa::vi;
 		    // WKernel applied (too bad that TempImages can't be
 		    // made with existing buffers)
 		    //
-		    //-------------------------------------------------------------		    
 		    TempImage<Complex> twoDPB_l(pbShape, cs_l);
-		    TempImage<Complex> twoDPBSq_l(pbShape,cs_l);
-		    //-------------------------------------------------------------		    
-		    // WBAWP CODE BEGIN -- ftATermSq_l has conj. PolCS
-		    cfWtBuf *= ftATerm_l.get()*conj(ftATermSq_l.get());
-		    //tim.mark();
-		    //UUU cfWtBuf *= ftATerm_l.get();
-		    cfBuf *= ftATerm_l.get();
-		    //tim.show("W*A*2: ");
-		    // WBAWP CODE END
-
-		    
-
-		    // cfWtBuf = sqrt(cfWtBuf);
-		    // psTerm.applySky(cfWtBufMat,true);
-
-		    //tim.mark();
 		    twoDPB_l.putSlice(cfBuf, PolnPlane);
-		    twoDPBSq_l.putSlice(cfWtBuf, PolnPlane);
-		    //tim.show("putSlice:");
-		    // WBAWP CODE BEGIN
-		    //		    twoDPB_l *= ftATerm_l;
-		    // WBAWP CODE END
-
-		    //		    twoDPBSq_l *= ftATermSq_l;//*conj(ftATerm_l);
-
-		    // To accumulate avgPB2, call this function. 
-		    // PBSQWeight
-		    Bool PBSQ = false;
-		    if(PBSQ) makePBSq(twoDPBSq_l); 
-		    
 
-		    //
-		    // Set the ref. freq. of the co-ordinate system to
-		    // that set by ATerm::applySky().
-		    //
-		    //tim.mark();
-    		    CoordinateSystem cs=twoDPB_l.coordinates();
-    		    Int index= twoDPB_l.coordinates().findCoordinate(Coordinate::SPECTRAL);
-    		    SpectralCoordinate SpCS = twoDPB_l.coordinates().spectralCoordinate(index);
-		    
-    		    Double cfRefFreq=SpCS.referenceValue()(0);
-    		    Vector<Double> refValue; refValue.resize(1); refValue(0)=cfRefFreq;
-    		    SpCS.setReferenceValue(refValue);
-    		    cs.replaceCoordinate(SpCS,index);
-		    //tim.show("CSStuff:");
-    		    // {
-		    // ostringstream name;
-		    //   name << "twoDPB.before" << iw << "_" << inu << "_" << muellerElements(imx)(imy) <<".im";
-    		    //   storeImg(name,twoDPB_l);
-		      // name << "twoDPBSq.before" << iw << "_" << inu << "_" << muellerElements(imx)(imy) <<".im";
-    		      // storeImg(name,twoDPBSq_l);
-    		    // }
 		    //
 		    // Now FT the function and copy the data from
 		    // TempImages back to the CFBuffer buffers
 		    //
-		    //tim.mark();
 		    if (!isDryRun)
-		      {
-			LatticeFFT::cfft2d(twoDPB_l);
-			LatticeFFT::cfft2d(twoDPBSq_l);
-		      }
-		    //tim.show("FFT*2:");
-		    // Array<Complex> t0;
-		    // twoDPBSq_l.get(t0); t0 = abs(t0);
-		    // twoDPBSq_l.put(t0);
+		      LatticeFFT::cfft2d(twoDPB_l);
 
-
-		    //tim.mark();
 		    IPosition shp(twoDPB_l.shape());
 		    IPosition start(4, 0, 0, 0, 0), pbSlice(4, shp[0]-1, shp[1]-1,1/*polInUse*/, 1),
 		      sliceLength(4,cfBuf.shape()[0]-1,cfBuf.shape()[1]-1,1,1);
 		    
 		    cfBuf(Slicer(start,sliceLength)).nonDegenerate()
 		      =(twoDPB_l.getSlice(start, pbSlice, true));
-		    
-		    shp = twoDPBSq_l.shape();
-		    IPosition pbSqSlice(4, shp[0]-1, shp[1]-1, 1, 1),
-		      sqSliceLength(4,cfWtBuf.shape()(0)-1,cfWtBuf.shape()[1]-1,1,1);
-		    
-		    cfWtBuf(Slicer(start,sqSliceLength)).nonDegenerate()
-		      =(twoDPBSq_l.getSlice(start, pbSqSlice, true));
-		    //tim.show("Slicer*2:");
 		    //
 		    // Finally, resize the buffers, limited to the
 		    // support size determined by the threshold
@@ -441,30 +344,75 @@ using namespace casa::vi;
 		    // the FT domain set the co-ord. sys. and modified
 		    // support sizes.
 		    //
-		    //tim.mark();
 		    Int supportBuffer = (Int)(getOversampling(psTerm, wTerm, aTerm)*1.5);
-		    if (!isDryRun)
+		    Vector<Double> ftRef(2);
+		    CoordinateSystem ftCoords;
+		    CountedPtr<CFCell> cfCellPtr;
+
+		    if (iw == 0)
 		      {
-			if (iw==0) wtcpeak = max(cfWtBuf);
-			cfWtBuf /= wtcpeak;
+			//
+			// The weight function (PS^2 x A x conj(A)) has
+			// no W-term and is therefore made only for the
+			// first w-plane.
+			//
+			cfWtBuf.resize(pbshp);
+			Matrix<Complex> cfWtBufMat(cfWtBuf.nonDegenerate());
+			if (psTerm.isNoOp() || isDryRun)
+			  cfWtBufMat = 1.0;
+			else
+			  {
+			    psTerm.applySky(cfWtBufMat, false); // Assign
+			    cfWtBuf *= cfWtBuf;
+			  }
+			// WBAWP CODE BEGIN -- ftATermSq_l has conj. PolCS
+			cfWtBuf *= ftATerm*conj(ftATermSq_l.get());
+			// WBAWP CODE END
+
+			TempImage<Complex> twoDPBSq_l(pbShape,cs_l);
+			twoDPBSq_l.putSlice(cfWtBuf, PolnPlane);
+
+			// To accumulate avgPB2, call this function. 
+			// PBSQWeight
+			Bool PBSQ = false;
+			if(PBSQ) makePBSq(twoDPBSq_l); 
+
+			if (!isDryRun)
+			  LatticeFFT::cfft2d(twoDPBSq_l);
+
+			shp = twoDPBSq_l.shape();
+			IPosition pbSqSlice(4, shp[0]-1, shp[1]-1, 1, 1),
+			  sqSliceLength(4,cfWtBuf.shape()(0)-1,cfWtBuf.shape()[1]-1,1,1);
+		    
+			cfWtBuf(Slicer(start,sqSliceLength)).nonDegenerate()
+			  =(twoDPBSq_l.getSlice(start, pbSqSlice, true));
+
+			if (!isDryRun)
+			  {
+			    wtcpeak = max(cfWtBuf);
+			    cfWtBuf /= wtcpeak;
+			    AWConvFunc::resizeCF(cfWtBuf, xSupportWt, ySupportWt, supportBuffer, samplingWt,0.0);
+			  }
+
+			cfWtNorm=0.0;
+			if (!isDryRun)
+			  cfWtNorm = AWConvFunc::cfArea(cfWtBufMat, xSupportWt, ySupportWt, sampling);
+			if (cfWtNorm != Complex(0.0)) cfWtBuf /= cfWtNorm;
+		      }
+		    else
+		      {
+			//
+			// Re-use the weight function of the first w-plane
+			// (with the support sizes found for it).
+			//
+			cfWtBuf.assign(*(cfWtb.getCFCellPtr(freqValues(inu), wValues(0), 
+							    muellerElements(imx)(imy))->storage_p));
 		      }
-		    //tim.show("Norm");
-
-		    //tim.mark();
-		    if (!isDryRun)
-		      AWConvFunc::resizeCF(cfWtBuf, xSupportWt, ySupportWt, supportBuffer, samplingWt,0.0);
-		    //log_l << "CF WT Support: " << xSupport << " (" << xSupportWt << ") " << "pixels" <<  LogIO::POST;
-		    //tim.show("Resize:");
 
-		    //tim.mark();
-		    Vector<Double> ftRef(2);
-		    // ftRef(0)=cfWtBuf.shape()(0)/2-1;
-		    // ftRef(1)=cfWtBuf.shape()(1)/2-1;
 		    ftRef(0)=cfWtBuf.shape()(0)/2.0;
 		    ftRef(1)=cfWtBuf.shape()(1)/2.0;
-		    CoordinateSystem ftCoords=cs_l;
+		    ftCoords=cs_l;
 		    SynthesisUtils::makeFTCoordSys(cs_l, cfWtBuf.shape()(0), ftRef, ftCoords);
-		    CountedPtr<CFCell> cfCellPtr;
 
 		    cfWtb.setParams(inu,iw,imx,imy,//muellerElements(imx)(imy),
 				    ftCoords, samplingWt, xSupportWt, ySupportWt,
@@ -475,26 +423,12 @@ using namespace casa::vi;
 						   muellerElements(imx)(imy));
 		    cfCellPtr->pa_p=Quantity(vbPA,"rad");
 		    cfCellPtr->telescopeName_p = aTerm.getTelescopeName();
-		    //cerr << "AWConvFunc: Telescope name = " << cfCellPtr->telescopeName_p << " " << aTerm.getTelescopeName() << endl;
-		    //tim.show("CSStuff:");
-		    // setUpCFSupport(cfBuf, xSupport, ySupport, sampling);
-		    //		    if (iw==0) 
-		    //tim.mark();
-		    //Int supportBuffer = (Int)(aTerm->getOversampling()*1.5);
 
 		    if (!isDryRun)
 		      {
 			cpeak = max(cfBuf);
 			cfBuf /= cpeak;
 		      }
-		    //tim.show("Peaknorm:");
-    		    // {
-    		    //   ostringstream name;
-    		    //   name << "twoDPB.after" << iw << "_" << inu << "_" << muellerElements(imx)(imy) << ".im";
-    		    //   storeImg(name,twoDPB_l);
-    		    //   // name << "twoDPBSq.after" << iw << "_" << inu << "_" << muellerElements(imx)(imy) << ".im";
-    		    //   // storeImg(name,twoDPBSq_l);
-    		    // }
 
 		    if (!isDryRun)
 		      AWConvFunc::resizeCF(cfBuf, xSupport, ySupport, supportBuffer, sampling,0.0);
@@ -502,29 +436,14 @@ using namespace casa::vi;
 		    if (!isDryRun)
 		      log_l << "CF Support: " << xSupport << " (" << xSupportWt << ") " << "pixels" <<  LogIO::POST;
 
-		    // cfb.getCFCellPtr(freqValues(inu), wValues(iw), muellerElement)->storage_p->assign(cfBuf);
-		    // ftRef(0)=cfBuf.shape()(0)/2-1;
-		    // ftRef(1)=cfBuf.shape()(1)/2-1;
 		    ftRef(0)=cfBuf.shape()(0)/2.0;
 		    ftRef(1)=cfBuf.shape()(1)/2.0;
 
-		    //tim.mark();
-		    cfNorm=cfWtNorm=0.0;
-		    //if ((iw == 0) && (!isDryRun))
+		    cfNorm=0.0;
 		    if (!isDryRun)
-		      {
-			cfNorm = AWConvFunc::cfArea(cfBufMat, xSupport, ySupport, sampling);
-			cfWtNorm = AWConvFunc::cfArea(cfWtBufMat, xSupportWt, ySupportWt, sampling);
-		      }
-		    //tim.show("Area*2:");
-
-		    //tim.mark();
+		      cfNorm = AWConvFunc::cfArea(cfBufMat, xSupport, ySupport, sampling);
 		    if (cfNorm != Complex(0.0)) cfBuf /= cfNorm;
-		    if (cfWtNorm != Complex(0.0)) cfWtBuf /= cfWtNorm;
-
-		    //tim.show("cfNorm*2:");
 
-		    //tim.mark();
 		    ftCoords=cs_l;
 		    SynthesisUtils::makeFTCoordSys(cs_l, cfBuf.shape()(0), ftRef, ftCoords);
 
@@ -548,8 +467,6 @@ using namespace casa::vi;
 					muellerElements(imx)(imy)))->initCache(isDryRun);
 		    (cfb.getCFCellPtr(freqValues(inu), wValues(iw), 
 				      muellerElements(imx)(imy)))->initCache(isDryRun);
-
-		    //tim.show("End*2:");
     		  }
 	      }
 	  }
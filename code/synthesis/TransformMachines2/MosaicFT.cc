@@ -318,6 +318,7 @@ void MosaicFT::initializeToVis(ImageInterface<Complex>& iimage,
   //make sure we rotate the first field too
   lastFieldId_p=-1;
   phaseShifter_p=new UVWMachine(*uvwMachine_p);
+  fieldMachines_p.clear();
   //findConvFunction(*image, vb);
   prepGridForDegrid();
 
@@ -468,6 +469,7 @@ void MosaicFT::initializeToSky(ImageInterface<Complex>& iimage,
   //make sure we rotate the first field too
   lastFieldId_p=-1;
   phaseShifter_p=new UVWMachine(*uvwMachine_p);
+  fieldMachines_p.clear();
   //findConvFunction(*image, vb);
   /*if((image->shape().product())>cachesize) {
     isTiled=true;
@@ -2149,14 +2151,13 @@ void  MosaicFT::girarUVW(Matrix<Double>& uvw, Vector<Double>& dphase,
     //image center is different from the phasecenter
     // UVrotation is false only if field never changes
   
-   ROMSColumns mscol(vb.getVi()->ms());
    if((vb.fieldId()(0)!=lastFieldId_p) || (vb.msId()!=lastMSId_p))
       doUVWRotation_p=true;
     if(doUVWRotation_p ||  fixMovingSource_p){
       
       mFrame_p.epoch() != 0 ? 
 	mFrame_p.resetEpoch(MEpoch(Quantity(vb.time()(0), "s"))):
-	mFrame_p.set(mLocation_p, MEpoch(Quantity(vb.time()(0), "s"), mscol.timeMeas()(0).getRef()));
+	mFrame_p.set(mLocation_p, MEpoch(Quantity(vb.time()(0), "s"), ROMSColumns(vb.getVi()->ms()).timeMeas()(0).getRef()));
       MDirection::Types outType;
       MDirection::getType(outType, mImage_p.getRefString());
       MDirection phasecenter=MDirection::Convert(vb.phaseCenter(), MDirection::Ref(outType, mFrame_p))();
@@ -2179,22 +2180,35 @@ void  MosaicFT::girarUVW(Matrix<Double>& uvw, Vector<Double>& dphase,
       // the tangent plane is specified then we need a UVWMachine that
       // will reproject to that plane iso the image plane
       if((vb.fieldId()(0)!=lastFieldId_p) || (vb.msId()!=lastMSId_p) || fixMovingSource_p) {
-	
-	String observatory=mscol.observation().telescopeName()(0);
-	if(uvwMachine_p) delete uvwMachine_p; uvwMachine_p=0;
-	if(observatory.contains("ATCA") || observatory.contains("WSRT")){
+	std::pair<Int, Int> fieldKey(vb.msId(), vb.fieldId()(0));
+	if(fixMovingSource_p || fieldMachines_p.count(fieldKey)==0){
+	  String observatory=ROMSObservationColumns(vb.getVi()->ms().observation()).telescopeName()(0);
+	  CountedPtr<UVWMachine> uvwMach, phaseShift;
+	  if(observatory.contains("ATCA") || observatory.contains("WSRT")){
 		//Tangent specified is being wrongly used...it should be for a
 	    	//Use the safest way  for now.
-	    uvwMachine_p=new UVWMachine(phasecenter, vb.phaseCenter(), mFrame_p,
+	    uvwMach=new UVWMachine(phasecenter, vb.phaseCenter(), mFrame_p,
 					true, false);
-	    phaseShifter_p=new UVWMachine(mImage_p, phasecenter, mFrame_p,
+	    phaseShift=new UVWMachine(mImage_p, phasecenter, mFrame_p,
 					true, false);
-	}
-	else{
-	  uvwMachine_p=new UVWMachine(phasecenter, vb.phaseCenter(),  mFrame_p,
+	  }
+	  else{
+	    uvwMach=new UVWMachine(phasecenter, vb.phaseCenter(),  mFrame_p,
 				      false, false);
-	  phaseShifter_p=new UVWMachine(mImage_p, phasecenter,  mFrame_p,
+	    phaseShift=new UVWMachine(mImage_p, phasecenter,  mFrame_p,
 				      false, false);
+	  }
+	  //a moving source needs new machines every time
+	  if(!fixMovingSource_p)
+	    fieldMachines_p[fieldKey]=std::make_pair(uvwMach, phaseShift);
+	  if(uvwMachine_p) delete uvwMachine_p;
+	  uvwMachine_p=new UVWMachine(*uvwMach);
+	  phaseShifter_p=phaseShift;
+	}
+	else{
+	  if(uvwMachine_p) delete uvwMachine_p;
+	  uvwMachine_p=new UVWMachine(*(fieldMachines_p[fieldKey].first));
+	  phaseShifter_p=fieldMachines_p[fieldKey].second;
 	}
       }
 
@@ -48,6 +48,7 @@
 #include <measures/Measures/MDirection.h>
 #include <measures/Measures/MPosition.h>
 #include <coordinates/Coordinates/DirectionCoordinate.h>
+#include <map>
 
 namespace casacore{
 
@@ -339,6 +340,9 @@ protected:
   casacore::TempImage<casacore::Complex>* convWeightImage_p;
   casacore::CountedPtr<SimplePBConvFunc> pbConvFunc_p;
   casacore::CountedPtr<casacore::UVWMachine> phaseShifter_p;
+  //uvw and phase rotation machines of the fields seen, by (ms, field),
+  //so that interleaved fields do not have to set them up again
+  std::map<std::pair<casacore::Int, casacore::Int>, std::pair<casacore::CountedPtr<casacore::UVWMachine>, casacore::CountedPtr<casacore::UVWMachine> > > fieldMachines_p;
  //Later this 
   casacore::String machineName_p;
   casacore::Bool doneWeightImage_p;
@@ -66,6 +66,7 @@
 #include <synthesis/TransformMachines2/SkyJones.h>
 
 #include <casa/Utilities/CompositeNumber.h>
+#include <casa/System/AipsrcValue.h>
 #include <math.h>
 
 using namespace casacore;
@@ -221,6 +222,7 @@ SimplePBConvFunc::SimplePBConvFunc(): nchan_p(-1),
     convSizes_p.resize(0, true);
     convSupportBlock_p.resize(0, true);
     convFunctionMap_p.clear();
+    shiftedConvFuncs_p.clear();
   }
 
 
@@ -317,6 +319,8 @@ void SimplePBConvFunc::findConvFunction(const ImageInterface<Complex>& iimage,
     }
 
     if(!(doneMainConv_p[actualConvIndex_p])){
+      //shifted versions of an older function are stale
+      shiftedConvFuncs_p.clear();
 
       //convSize_p=4*(sj_p->support(vb, coords));
       convSize_p=Int(max(nx_p, ny_p)/2)*2*convSamp;
@@ -765,36 +769,65 @@ void SimplePBConvFunc::findConvFunction(const ImageInterface<Complex>& iimage,
     }
 
     //Apply the shift phase gradient
+    //unless this pointing was shifted recently
+    std::list<ShiftedConvFunc>::iterator shifted=shiftedConvFuncs_p.begin();
+    while(shifted != shiftedConvFuncs_p.end() && !(shifted->convIndex==actualConvIndex_p
+	  && shifted->shiftX==pixFieldDir(0) && shifted->shiftY==pixFieldDir(1)))
+      ++shifted;
+    if(shifted != shiftedConvFuncs_p.end()){
+      shiftedConvFuncs_p.splice(shiftedConvFuncs_p.begin(), shiftedConvFuncs_p, shifted);
+    }
+    else{
+      shiftedConvFuncs_p.push_front(ShiftedConvFunc());
+      ShiftedConvFunc& newShift=shiftedConvFuncs_p.front();
+      newShift.convIndex=actualConvIndex_p;
+      newShift.shiftX=pixFieldDir(0);
+      newShift.shiftY=pixFieldDir(1);
+      newShift.conv.assign(*(convFunctions_p[actualConvIndex_p]));
+      newShift.weight.assign(*(convWeights_p[actualConvIndex_p]));
+      Bool copyconv, copywgt;
+      Complex *cv=newShift.conv.getStorage(copyconv);
+      Complex *wcv=newShift.weight.getStorage(copywgt);
+      //cerr << "Field " << vb.fieldId() << " spw " << vb.spectralWindow() << " phase grad: " << pixFieldDir << endl;
+      //the x phases are the same for every row and channel
+      Vector<Complex> phx(convSize_p);
+      for (Int ix=0;ix<convSize_p;ix++) {
+	Double cx, sx;
+	SINCOS(Double(ix-convSize_p/2)*pixFieldDir(0), sx, cx);
+	phx[ix]=Complex(cx,sx);
+      }
+      for (Int iy=0;iy<convSize_p;iy++) {
+	Double cy, sy;
+	SINCOS(Double(iy-convSize_p/2)*pixFieldDir(1), sy, cy);
+	Complex phy(cy,sy) ;
+	for (Int nc=0; nc < nBeamChans; ++nc){ 
+	  Int offset = iy*convSize_p+nc*convSize_p*convSize_p;
+	  for (Int ix=0;ix<convSize_p;ix++) {
+	    cv[ix+offset]= cv[ix+offset]*phx[ix]*phy;
+	    wcv[ix+offset]= wcv[ix+offset]*phx[ix]*phy;
+	  }
+	}
+      }
+      newShift.conv.putStorage(cv, copyconv);
+      newShift.weight.putStorage(wcv, copywgt);
+      //keep the shifted functions within mosaic.cfcache.size MB
+      Int cacheMB;
+      AipsrcValue<Int>::find(cacheMB, "mosaic.cfcache.size", 256);
+      Double bytesLeft=Double(cacheMB)*1024.0*1024.0
+	-Double(newShift.conv.nelements()+newShift.weight.nelements())*sizeof(Complex);
+      std::list<ShiftedConvFunc>::iterator keep=shiftedConvFuncs_p.begin();
+      for (++keep; keep != shiftedConvFuncs_p.end(); ++keep){
+	bytesLeft-=Double(keep->conv.nelements()+keep->weight.nelements())*sizeof(Complex);
+	if(bytesLeft < 0.0)
+	  break;
+      }
+      shiftedConvFuncs_p.erase(keep, shiftedConvFuncs_p.end());
+    }
+    //callers get their own copy
     convFunc.resize();
     weightConvFunc.resize();
-    convFunc.assign(*(convFunctions_p[actualConvIndex_p]));
-    weightConvFunc.assign(*(convWeights_p[actualConvIndex_p]));
-    Bool copyconv, copywgt;
-    Complex *cv=convFunc.getStorage(copyconv);
-    Complex *wcv=weightConvFunc.getStorage(copywgt);
-    //cerr << "Field " << vb.fieldId() << " spw " << vb.spectralWindow() << " phase grad: " << pixFieldDir << endl;
-   
-    for (Int nc=0; nc < nBeamChans; ++nc){ 
-    	Int planeoffset=nc*convSize_p*convSize_p;
-    	for (Int iy=0;iy<convSize_p;iy++) {
-    		Double cy, sy;
-		Int offset;
-	       
-    		SINCOS(Double(iy-convSize_p/2)*pixFieldDir(1), sy, cy);
-    		Complex phy(cy,sy) ;
-    		offset = iy*convSize_p+planeoffset;
-    		for (Int ix=0;ix<convSize_p;ix++) {
-    			Double cx, sx;
-    			SINCOS(Double(ix-convSize_p/2)*pixFieldDir(0), sx, cx);
-    			Complex phx(cx,sx) ;
-			cv[ix+offset]= cv[ix+offset]*phx*phy;
-			wcv[ix+offset]= wcv[ix+offset]*phx*phy;
-
-    		}
-    	}
-    }
-    convFunc.putStorage(cv, copyconv);
-    weightConvFunc.putStorage(wcv, copywgt);
+    convFunc.assign(shiftedConvFuncs_p.front().conv);
+    weightConvFunc.assign(shiftedConvFuncs_p.front().weight);
     convsize.resize();
     convsize=*(convSizes_p[actualConvIndex_p]);
     convSupport.resize();
@@ -991,6 +1024,7 @@ void SimplePBConvFunc::findConvFunction(const ImageInterface<Complex>& iimage,
 	 throw(AipsError("Wrong record to recover HetArray from"));
 	}
        rec.get("numconv", numConv);
+       shiftedConvFuncs_p.clear();
        convFunctions_p.resize(numConv, true, false);
        convSupportBlock_p.resize(numConv, true, false);
        convWeights_p.resize(numConv, true, false);
@@ -34,6 +34,7 @@
 #include <casa/Utilities/CountedPtr.h>
 #include <msvis/MSVis/VisBufferUtil.h>
 #include <synthesis/Utilities/FFT2D.h>
+#include <list>
 
 #include <wcslib/wcsconfig.h>  /** HAVE_SINCOS **/
 
@@ -192,6 +193,15 @@ namespace refim{ //namespace for imaging refactor
       casacore::Block <casacore::CountedPtr<casacore::Vector<casacore::Int> > > convSupportBlock_p;
       casacore::Matrix<casacore::Bool> pointingPix_p;
       VisBufferUtil vbUtil_p;
+      //Phase shifted functions of recently seen pointings, most recent
+      //first, so interleaved fields need not be shifted again
+      struct ShiftedConvFunc{
+	casacore::Int convIndex;
+	casacore::Double shiftX, shiftY;
+	casacore::Array<casacore::Complex> conv;
+	casacore::Array<casacore::Complex> weight;
+      };
+      std::list<ShiftedConvFunc> shiftedConvFuncs_p;
       
     };
   }; //end of refim namespace
@@ -36,6 +36,10 @@
 #include <casa/Arrays/Matrix.h>
 #include <casa/Arrays/Cube.h>
 #include <casa/OS/HostInfo.h>
+#include <casa/OS/RegularFile.h>
+#include <casa/IO/AipsIO.h>
+#include <casa/Arrays/ArrayIO.h>
+#include <casa/System/Aipsrc.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Utilities/CompositeNumber.h>
 #include <coordinates/Coordinates/CoordinateSystem.h>
@@ -595,9 +599,28 @@ WPConvFunc::WPConvFunc(const WPConvFunc& other): convFunctionMap_p(-1),
   coords.replaceCoordinate(dc, directionIndex);
   //  coords.list(os, MDoppler::RADIO, IPosition(), IPosition());
   
-  IPosition pbShape(4, convSize, convSize, 1, 1);
-  TempImage<Complex> twoDPB(pbShape, coords);
+  //IPosition pbShape(4, convSize, convSize, 1, 1);
+  //TempImage<Complex> twoDPB(pbShape, coords);
 
+  //Kernels of an earlier run with the same geometry can be reused from
+  //the directory in aipsrc wproject.cfcache.directory
+  String bankName;
+  {
+    String bankDir;
+    Aipsrc::find(bankDir, "wproject.cfcache.directory", "");
+    if(bankDir != ""){
+      Vector<Double> incr=coords.directionCoordinate(directionIndex).increment();
+      ostringstream oos;
+      oos << setprecision(12);
+      oos << bankDir << "/WPConvFunc_" << nx_p << "_" << ny_p << "_" << fabs(incr(0)) << "_" << fabs(incr(1))
+	  << "_" << convSize << "_" << convSampling_p << "_" << wConvSize << "_" << (wConvSize > 1 ? wScaler_p : 0.0);
+      bankName=String(oos);
+    }
+  }
+  if(bankName != "" && readKernelBank(bankName, convFunc, convSupport, convSize)){
+    os << "Using the w-projection kernels saved in " << bankName << LogIO::POST;
+  }
+  else{
   Int inner=convSize/convSampling_p;
   ConvolveGridder<Double, Complex>
     ggridder(IPosition(2, inner, inner), uvScale, uvOffset, "SF");
@@ -607,14 +630,9 @@ WPConvFunc::WPConvFunc(const WPConvFunc& other): convFunctionMap_p(-1),
 		       cn.nextLargerEven(Int(padding*Float(ny_p)-0.5))), uvScale, 
 	     uvOffset, "SF");
   */
-  convFunc.resize(); // break any reference 
-  convFunc.resize(convSize/2-1, convSize/2-1, wConvSize);
-  convFunc.set(0.0);
-  Bool convFuncStor=false;
-  Complex *convFuncPtr=convFunc.getStorage(convFuncStor);
-
-  IPosition start(4, 0, 0, 0, 0);
-  IPosition pbSlice(4, convSize, convSize, 1, 1);
+  //Each plane keeps only the quarter within its own support; the
+  //support against the peak of all planes can only be smaller
+  std::vector<Matrix<Complex> > planes(wConvSize);
   
   //Bool writeResults=false;
   Int warner=0;
@@ -653,8 +671,10 @@ WPConvFunc::WPConvFunc(const WPConvFunc& other): convFunctionMap_p(-1),
    Int cpConvSize=convSize;
    Int cpWConvSize=wConvSize;
    Double cpWscale=wScale;
+   Int cpConvSampling=convSampling_p;
+   std::vector<Matrix<Complex> > *planesptr=&planes;
    //Float max0=1.0;
-#pragma omp parallel for default(none) firstprivate(cpWConvSize, cpConvSize, convFuncPtr, s0, s1, wsaveptr, ier, lsav, cor, inner, maxptr, cpWscale ) 
+#pragma omp parallel for default(none) firstprivate(cpWConvSize, cpConvSize, s0, s1, wsaveptr, ier, lsav, cor, inner, maxptr, cpWscale, cpConvSampling, maxConvSize, planesptr) 
 
   for (Int iw=0; iw< cpWConvSize;iw++) {
     // First the w term
@@ -692,32 +712,8 @@ WPConvFunc::WPConvFunc(const WPConvFunc& other): convFunctionMap_p(-1),
     else {
       screen=1.0;
     }
-    /////////screen.putStorage(scr, cpscr);
-    
-    // spheroidal function
-    /*    Vector<Complex> correction(inner);
-    for (Int iy=-inner/2;iy<inner/2;iy++) {
-      ggridder.correctX1D(correction, iy+inner/2);
-      for (Int ix=-inner/2;ix<inner/2;ix++) {
-	screen(ix+convSize/2,iy+convSize/2)*=correction(ix+inner/2);
-      }
-    }
-    */
-    //twoDPB.putSlice(screen, IPosition(4, 0));
-    // Write out screen as an image
-    /*if(writeResults) {
-      ostringstream name;
-      name << "Screen" << iw+1;
-      if(Table::canDeleteTable(name)) Table::deleteTable(name);
-      PagedImage<Float> thisScreen(pbShape, coords, name);
-      LatticeExpr<Float> le(real(twoDPB));
-      thisScreen.copyData(le);
-    }
-    */
-
     
  // Now FFT and get the result back
-    //LatticeFFT::cfft2d(twoDPB);
     /////////Por FFTPack
     Vector<Float>work(2*cpConvSize*cpConvSize);
     Int lenwrk=2*cpConvSize*cpConvSize;
@@ -726,56 +722,30 @@ WPConvFunc::WPConvFunc(const WPConvFunc& other): convFunctionMap_p(-1),
     FFTPack::cfft2f(cpConvSize, cpConvSize, cpConvSize, scr, wsaveptr, lsav, workptr, lenwrk, ier);
    
     screen.putStorage(scr, cpscr);
-    /////////////////////
-    // Write out FT of screen as an image
-    /*if(1) {
-      CoordinateSystem ftCoords(coords);
-      directionIndex=ftCoords.findCoordinate(Coordinate::DIRECTION);
-      AlwaysAssert(directionIndex>=0, AipsError);
-      dc=coords.directionCoordinate(directionIndex);
-      Vector<Bool> axes(2); axes(0)=true;axes(1)=true;
-      Vector<Int> shape(2); shape(0)=convSize;shape(1)=convSize;
-      Coordinate* ftdc=dc.makeFourierCoordinate(axes,shape);
-      ftCoords.replaceCoordinate(*ftdc, directionIndex);
-      delete ftdc; ftdc=0;
-      ostringstream name;
-      name << "FTScreen" << iw+1;
-      if(Table::canDeleteTable(name)) Table::deleteTable(name);
-      PagedImage<Float> thisScreen(pbShape, ftCoords, name);
-      //LatticeExpr<Float> le(real(twoDPB));
-      //thisScreen.copyData(le);
-      thisScreen.put(real(screen));
-    }
-    */
-    ////////IPosition start(4, convSize/2, convSize/2, 0, 0);
-    ////////IPosition pbSlice(4, convSize/2-1, convSize/2-1, 1, 1);
-    ///////convFunc.xyPlane(iw)=twoDPB.getSlice(start, pbSlice, true);
-    //////Matrix<Complex> quarter(twoDPB.getSlice(start, pbSlice, true));
-    //   cerr << "quartershape " << quarter.shape() << endl;
-    ooLong offset=ooLong(ooLong(iw)*ooLong(cpConvSize/2-1)*ooLong(cpConvSize/2-1));
-    //    cerr << "offset " << offset << " convfuncshape " << convFunc.shape() << " convSize " << convSize  << endl;
     maxptr[iw]=screen(0,0);
-    for (ooLong y=0; y< ooLong(cpConvSize/2)-1; ++y){
-      for (ooLong x=0; x< ooLong(cpConvSize/2)-1; ++x){
-	////////convFuncPtr[offset+y*(convSize/2-1)+x] = quarter(x,y);
-	convFuncPtr[offset+y*ooLong(cpConvSize/2-1)+x] = screen(x,y);
+    //Extent of this plane against its own peak, with room for the
+    //fractional offsets the gridder adds to the support
+    Int ext=cpConvSize/2-1;
+    Float ownThresh=1e-3*abs(screen(0,0));
+    for (Int trial=cpConvSize/2-2;trial>0;trial--) {
+      if((abs(screen(trial,0))>ownThresh)||(abs(screen(0,trial))>ownThresh) ) {
+	Int ownSupp=Int(0.5+Float(trial)/Float(cpConvSampling))+1;
+	if(ownSupp*cpConvSampling*2 < maxConvSize)
+	  ext=min(ext, (ownSupp+2)*cpConvSampling);
+	break;
       }
     }
-
-
-
+    (*planesptr)[iw]=screen(IPosition(2, 0, 0), IPosition(2, ext-1, ext-1));
   }
   
-  convFunc.putStorage(convFuncPtr, convFuncStor);
   corr.putStorage(cor, cpcor);
   maxes.putStorage(maxptr, maxdel);
   //tim.show("After convFunc making ");
 //Complex maxconv=max(abs(convFunc));
  Complex maxconv=max(abs(maxes));
  //cerr << maxes << " maxconv " << maxconv << endl;
- //Do it by plane as the / operator makes a copy of the whole array
  for (uInt iw=0; iw< uInt(wConvSize); ++iw)
-   convFunc.xyPlane(iw)=convFunc.xyPlane(iw)/real(maxconv);
+   planes[iw]=planes[iw]/real(maxconv);
  //tim.show("After convFunc norming ");
   // Find the edge of the function by stepping in from the
   // uv plane edge. We do this for each plane to save time on the
@@ -787,15 +757,14 @@ WPConvFunc::WPConvFunc(const WPConvFunc& other): convFunctionMap_p(-1),
 #endif
   Bool delsupstor;
   Int* suppstor=pcsupp.getStorage(delsupstor);
-  convFuncPtr=convFunc.getStorage(convFuncStor);
-#pragma omp parallel for default(none) firstprivate(suppstor, cpConvSize, cpWConvSize, convFuncPtr, maxConvSize) reduction(+: warner) 
+#pragma omp parallel for default(none) firstprivate(suppstor, cpConvSize, cpWConvSize, planesptr, maxConvSize) reduction(+: warner) 
   for (Int iw=0;iw<cpWConvSize;iw++) {
     Bool found=false;
     Int trial=0;
-    ooLong ploffset=(ooLong)(cpConvSize/2-1)*(ooLong)(cpConvSize/2-1)*(ooLong)iw;
-    for (trial=cpConvSize/2-2;trial>0;trial--) {
-      // if((abs(convFunc(trial,0,iw))>1e-3)||(abs(convFunc(0,trial,iw))>1e-3) ) {
-      if((abs(convFuncPtr[(ooLong)(trial)+ploffset])>1e-3)||(abs(convFuncPtr[(ooLong)(trial*(cpConvSize/2-1))+ploffset])>1e-3) ) {
+    const Matrix<Complex>& plane=(*planesptr)[iw];
+    //beyond the kept extent the plane is below threshold
+    for (trial=min(cpConvSize/2-2, Int(plane.nrow())-1);trial>0;trial--) {
+      if((abs(plane(trial,0))>1e-3)||(abs(plane(0,trial))>1e-3) ) {
 	//cout <<"iw " << iw << " x " << abs(convFunc(trial,0,iw)) << " y " 
 	//   <<abs(convFunc(0,trial,iw)) << endl; 
 	found=true;
@@ -830,38 +799,21 @@ WPConvFunc::WPConvFunc(const WPConvFunc& other): convFunctionMap_p(-1),
 	    << "You may consider reducing the size of your image or use facets"
 	    << LogIO::POST;
   }
-  /*
-  if(1) {
-      CoordinateSystem ftCoords(coords);
-      Int directionIndex=ftCoords.findCoordinate(Coordinate::DIRECTION);
-      AlwaysAssert(directionIndex>=0, AipsError);
-      dc=coords.directionCoordinate(directionIndex);
-      Vector<Bool> axes(2); axes(0)=true;axes(1)=true;
-      Vector<Int> shape(2); shape(0)=convSize;shape(1)=convSize;
-      Coordinate* ftdc=dc.makeFourierCoordinate(axes,shape);
-      ftCoords.replaceCoordinate(*ftdc, directionIndex);
-      delete ftdc; ftdc=0;
-      ostringstream name;
-      name << "FTScreenWproj" ;
-      if(Table::canDeleteTable(name)) Table::deleteTable(name);
-      PagedImage<Complex> thisScreen(IPosition(4, convFunc.shape()(0), convFunc.shape()(1), 1, convFunc.shape()(2)), ftCoords, name);
-      thisScreen.put(convFunc.reform(IPosition(4, convFunc.shape()(0), convFunc.shape()(1), 1, convFunc.shape()(2))));
-  }
-  */
 
 
   // Normalize such that plane 0 sums to 1 (when jumping in
   // steps of convSampling)
   Double pbSum=0.0;
+  const Matrix<Complex>& plane0=planes[0];
   for (Int iy=-convSupport(0);iy<=convSupport(0);iy++) {
     for (Int ix=-convSupport(0);ix<=convSupport(0);ix++) {
-      pbSum+=real(convFunc(abs(ix)*convSampling_p,abs(iy)*convSampling_p,0));
+      uInt px=abs(ix)*convSampling_p;
+      uInt py=abs(iy)*convSampling_p;
+      if(px < plane0.nrow() && py < plane0.ncolumn())
+	pbSum+=real(plane0(px, py));
     }
   }
-  if(pbSum>0.0) {
-    convFunc*=Complex(1.0/pbSum,0.0);
-  }
-  else {
+  if(pbSum<=0.0) {
     os << "Convolution function integral is not positive"
 	    << LogIO::EXCEPTION;
   } 
@@ -871,26 +823,35 @@ WPConvFunc::WPConvFunc(const WPConvFunc& other): convFunctionMap_p(-1),
 
   //tim.show("After pbsumming ");
 
+  //Only the part out to the largest support is stored, zero beyond
+  //where a plane was kept
+  Int newConvSize=2*(max(convSupport)+2)*convSampling;
+  if(newConvSize >= convSize)
+    newConvSize=convSize;
+  convFunc.resize(); // break any reference 
+  convFunc.resize(newConvSize/2-1, newConvSize/2-1, wConvSize);
+  convFunc.set(0.0);
+  for (Int iw=0; iw < wConvSize; ++iw){
+    Int ext=min(Int(planes[iw].nrow()), newConvSize/2-1);
+    if(ext > 0){
+      IPosition blc(2, 0, 0);
+      IPosition trc(2, ext-1, ext-1);
+      Matrix<Complex> convPlane(convFunc.xyPlane(iw));
+      convPlane(blc, trc)=planes[iw](blc, trc)*Complex(1.0/pbSum,0.0);
+    }
+    planes[iw].resize();
+  }
+  convSize=newConvSize;
+  if(bankName != "")
+    writeKernelBank(bankName, convFunc, convSupport, convSize);
+  }
+
   convSupportBlock_p.resize(actualConvIndex_p+1);
   convSupportBlock_p[actualConvIndex_p]= new Vector<Int>();
   convSupportBlock_p[actualConvIndex_p]->assign(convSupport);
   convFunctions_p.resize(actualConvIndex_p+1);
   convFunctions_p[actualConvIndex_p]= new Cube<Complex>();
-  Int newConvSize=2*(max(convSupport)+2)*convSampling;
-  
-  if(newConvSize < convSize){
-    IPosition blc(3, 0,0,0);
-    IPosition trc(3, (newConvSize/2-2),
-		  (newConvSize/2-2),
-		  convSupport.shape()(0)-1);
-   
-    *(convFunctions_p[actualConvIndex_p])=convFunc(blc,trc);
-    // convFunctions_p[actualConvIndex_p]->assign(Cube<Complex>(convFunc(blc,trc)));
-    convSize=newConvSize;
-  }
-  else{
-    *(convFunctions_p[actualConvIndex_p])=convFunc;
-  }
+  *(convFunctions_p[actualConvIndex_p])=convFunc;
   // read out memory size from aisprc if exists
   Int maxMemoryMB=HostInfo::memoryTotal(true)/1024;
   Int memoryMB;
@@ -955,6 +916,50 @@ Bool WPConvFunc::checkCenterPix(const ImageInterface<Complex>& image){
   return true;
 }
 
+Bool WPConvFunc::readKernelBank(const String& name, Cube<Complex>& convFunc,
+				Vector<Int>& convSupport, Int& convSize){
+  if(!File(name).exists())
+    return false;
+  try{
+    AipsIO ios(name, ByteIO::Old);
+    ios.getstart("WPConvFunc");
+    convFunc.resize();
+    convSupport.resize();
+    ios >> convSize >> convSupport >> convFunc;
+    ios.getend();
+  }
+  catch(AipsError x){
+    LogIO os(LogOrigin("WPConvFunc", "readKernelBank"));
+    os << LogIO::WARN << "Could not read w-projection kernels from " << name
+       << ": " << x.getMesg() << LogIO::POST;
+    return false;
+  }
+  return true;
+}
+
+void WPConvFunc::writeKernelBank(const String& name, const Cube<Complex>& convFunc,
+				 const Vector<Int>& convSupport, const Int convSize){
+  //Write aside and move into place so that a concurrent run never
+  //reads a partial file
+  ostringstream oos;
+  oos << name << "_tmp" << HostInfo::processID();
+  String tmpName(oos);
+  try{
+    {
+      AipsIO ios(tmpName, ByteIO::New);
+      ios.putstart("WPConvFunc", 1);
+      ios << convSize << convSupport << convFunc;
+      ios.putend();
+    }
+    RegularFile(tmpName).move(name);
+  }
+  catch(AipsError x){
+    LogIO os(LogOrigin("WPConvFunc", "writeKernelBank"));
+    os << LogIO::WARN << "Could not save w-projection kernels to " << name
+       << ": " << x.getMesg() << LogIO::POST;
+  }
+}
+
 Bool WPConvFunc::toRecord(RecordInterface& rec){
 
   Int numConv=convFunctions_p.nelements();
@@ -103,6 +103,11 @@ namespace refim{// namespace for imaging refactoring
       casacore::Bool fromRecord(casacore::String& err, const casacore::RecordInterface& rec);
     private:
       casacore::Bool checkCenterPix(const casacore::ImageInterface<casacore::Complex>& image);
+      //Kernels saved on disk by an earlier run, and saving them
+      casacore::Bool readKernelBank(const casacore::String& name, casacore::Cube<casacore::Complex>& convFunc,
+				    casacore::Vector<casacore::Int>& convSupport, casacore::Int& convSize);
+      void writeKernelBank(const casacore::String& name, const casacore::Cube<casacore::Complex>& convFunc,
+			   const casacore::Vector<casacore::Int>& convSupport, const casacore::Int convSize);
       casacore::Block <casacore::CountedPtr<casacore::Cube<casacore::Complex> > > convFunctions_p;
       casacore::Block <casacore::CountedPtr<casacore::Vector<casacore::Int> > > convSupportBlock_p;
       casacore::SimpleOrderedMap <casacore::String, casacore::Int> convFunctionMap_p;
@@ -38,12 +38,9 @@
 using namespace casacore;
 namespace casa { //# NAMESPACE CASA - BEGIN
 
-  FFT2D::FFT2D(Bool useFFTW): useFFTW_p(useFFTW), wsave_p(0), lsav_p(0){
+  FFT2D::FFT2D(Bool useFFTW): planC2C_p(NULL), planR2C_p(NULL), planC2CD_p(NULL), useFFTW_p(useFFTW), wsave_p(0), lsav_p(0){
     if(useFFTW_p){
-      Int numThreads=HostInfo::numCPUs(true);
-#ifdef _OPENMP
-      numThreads=omp_get_max_threads();
-#endif      
+      Int numThreads=planThreads();
       fftwf_init_threads();
       fftwf_plan_with_nthreads(numThreads);
       ///For double precision
@@ -51,17 +48,20 @@ namespace casa { //# NAMESPACE CASA - BEGIN
       fftw_plan_with_nthreads(numThreads);
     }
    
+  }
+  FFT2D::FFT2D(const FFT2D& other): planC2C_p(NULL), planR2C_p(NULL), planC2CD_p(NULL), useFFTW_p(other.useFFTW_p), wsave_p(other.wsave_p), lsav_p(other.lsav_p){
+
   }
   FFT2D::~FFT2D(){
-    if(useFFTW_p)
-       fftw_cleanup_threads();
+    ///Do not call fftw_cleanup_threads here: it invalidates the plans
+    ///held by every other FFT2D alive
+    clearPlans();
 
   }
 
   FFT2D& FFT2D::operator=(const FFT2D& other){
     if(this != &other){
-      planC2C_p=other.planC2C_p;
-      planR2C_p=other.planR2C_p;
+      clearPlans();
       useFFTW_p=other.useFFTW_p;
       wsave_p.resize(other.wsave_p.size());
       wsave_p=other.wsave_p;
@@ -71,6 +71,29 @@ namespace casa { //# NAMESPACE CASA - BEGIN
     return *this;
   }
 
+  Int FFT2D::planThreads() const{
+    Int numThreads=HostInfo::numCPUs(true);
+#ifdef _OPENMP
+    numThreads=omp_get_max_threads();
+#endif      
+    return numThreads;
+  }
+
+  void FFT2D::clearPlans(){
+    if(planC2C_p)
+      fftwf_destroy_plan(planC2C_p);
+    if(planR2C_p)
+      fftwf_destroy_plan(planR2C_p);
+    if(planC2CD_p)
+      fftw_destroy_plan(planC2CD_p);
+    planC2C_p=NULL;
+    planR2C_p=NULL;
+    planC2CD_p=NULL;
+    keyC2C_p=PlanKey();
+    keyR2C_p=PlanKey();
+    keyC2CD_p=PlanKey();
+  }
+
   void FFT2D::r2cFFT(Lattice<Complex>& out, Lattice<Float>& in){
     
     IPosition shp=in.shape();
@@ -273,18 +296,18 @@ namespace casa { //# NAMESPACE CASA - BEGIN
   void FFT2D::doFFT(DComplex*& out, Long x, Long y, Bool toFreq){
     if(useFFTW_p){
       //Will need to seperate the plan from the execute if we want to run this in multiple threads
-      Int dim[2]={Int(x), Int(y)};
-      if(toFreq){
-	
-	planC2CD_p=fftw_plan_dft(2, dim,  reinterpret_cast<fftw_complex *>(out),  reinterpret_cast<fftw_complex *>(out), FFTW_FORWARD, FFTW_ESTIMATE);
-      
-	//fft1_p.plan_c2c_forward(IPosition(2, x, y),  out);
-      }
-      else{
-	planC2CD_p=fftw_plan_dft(2, dim,  reinterpret_cast<fftw_complex *>(out),  reinterpret_cast<fftw_complex *>(out), FFTW_BACKWARD, FFTW_ESTIMATE);
-	//  fft1_p.plan_c2c_backward(IPosition(2, x, y),  out);
+      fftw_complex* data=reinterpret_cast<fftw_complex *>(out);
+      Int align=fftw_alignment_of(reinterpret_cast<Double *>(out));
+      PlanKey key(x, y, toFreq ? FFTW_FORWARD : FFTW_BACKWARD, align, align, planThreads());
+      if(!planC2CD_p || !(key==keyC2CD_p)){
+	if(planC2CD_p)
+	  fftw_destroy_plan(planC2CD_p);
+	fftw_plan_with_nthreads(key.nthreads);
+	Int dim[2]={Int(x), Int(y)};
+	planC2CD_p=fftw_plan_dft(2, dim, data, data, key.sign, FFTW_ESTIMATE);
+	keyC2CD_p=key;
       }
-      fftw_execute(planC2CD_p);
+      fftw_execute_dft(planC2CD_p, data, data);
       
     }
     else{
@@ -294,25 +317,26 @@ namespace casa { //# NAMESPACE CASA - BEGIN
    void FFT2D::doFFT(Complex*& out, Long x, Long y, Bool toFreq){
     if(useFFTW_p){
       //Will need to seperate the plan from the execute if we want to run this in multiple threads
-      Int dim[2]={Int(x), Int(y)};
-      if(toFreq){
-	
-	planC2C_p=fftwf_plan_dft(2, dim,  reinterpret_cast<fftwf_complex *>(out),  reinterpret_cast<fftwf_complex *>(out), FFTW_FORWARD, FFTW_ESTIMATE);
-      
-	//fft1_p.plan_c2c_forward(IPosition(2, x, y),  out);
-      }
-      else{
-	planC2C_p=fftwf_plan_dft(2, dim,  reinterpret_cast<fftwf_complex *>(out),  reinterpret_cast<fftwf_complex *>(out), FFTW_BACKWARD, FFTW_ESTIMATE);
-	//  fft1_p.plan_c2c_backward(IPosition(2, x, y),  out);
+      fftwf_complex* data=reinterpret_cast<fftwf_complex *>(out);
+      Int align=fftwf_alignment_of(reinterpret_cast<Float *>(out));
+      PlanKey key(x, y, toFreq ? FFTW_FORWARD : FFTW_BACKWARD, align, align, planThreads());
+      if(!planC2C_p || !(key==keyC2C_p)){
+	if(planC2C_p)
+	  fftwf_destroy_plan(planC2C_p);
+	fftwf_plan_with_nthreads(key.nthreads);
+	Int dim[2]={Int(x), Int(y)};
+	planC2C_p=fftwf_plan_dft(2, dim, data, data, key.sign, FFTW_ESTIMATE);
+	keyC2C_p=key;
       }
-      fftwf_execute(planC2C_p);
+      fftwf_execute_dft(planC2C_p, data, data);
       
     }
     else{
       Int ier;
       Int x1=Int(x);
       Int y1=Int(y);
-      if(wsave_p.size()==0){
+      ///The saved factors are only valid for the size they were made for
+      if(wsave_p.size()==0 || lsav_p != 2*x1*y1+15){
 	wsave_p.resize(2*x1*y1+15);
 	lsav_p=2*x1*y1+15;
 	Float *wsaveptr=wsave_p.data();
@@ -330,13 +354,17 @@ namespace casa { //# NAMESPACE CASA - BEGIN
   }
   void FFT2D::doFFT(Complex*& out, Float*& in, Long x, Long y){
     if(useFFTW_p){
-      Int dim[2]={Int(x), Int(y)};
-	
-      planR2C_p=fftwf_plan_dft_r2c(2, dim,  in, reinterpret_cast<fftwf_complex *>(out), FFTW_ESTIMATE);
-      
-      //fft1_p.plan_c2c_forward(IPosition(2, x, y),  out);
-     
-      fftwf_execute(planR2C_p);
+      fftwf_complex* data=reinterpret_cast<fftwf_complex *>(out);
+      PlanKey key(x, y, FFTW_FORWARD, fftwf_alignment_of(in), fftwf_alignment_of(reinterpret_cast<Float *>(out)), planThreads());
+      if(!planR2C_p || !(key==keyR2C_p)){
+	if(planR2C_p)
+	  fftwf_destroy_plan(planR2C_p);
+	fftwf_plan_with_nthreads(key.nthreads);
+	Int dim[2]={Int(x), Int(y)};
+	planR2C_p=fftwf_plan_dft_r2c(2, dim,  in, data, FFTW_ESTIMATE);
+	keyR2C_p=key;
+      }
+      fftwf_execute_dft_r2c(planR2C_p, in, data);
       
     }
     else{
@@ -38,6 +38,8 @@ namespace casa{
    //Assumes 2D x, y array to be even numbers (e.g (100, 200)...will not work for (101, 200))
  public:
    FFT2D(casacore::Bool useFFTW=true);
+   //Plans are not shared between copies; each one makes its own as needed
+   FFT2D(const FFT2D& other);
    ~FFT2D();
    FFT2D& operator=(const FFT2D& other);
    //out has to be a pointer to an array [(x/2+1), y] shape 
@@ -60,10 +62,24 @@ namespace casa{
    void doFFT(casacore::DComplex*& out, casacore::Long x, casacore::Long y, casacore::Bool toFreq);
    void doFFT(casacore::Complex*& out, casacore::Float *& in, casacore::Long x, casacore::Long y);
  private:
+   //Size, direction, data alignment and number of threads a cached plan was made for
+   struct PlanKey{
+     casacore::Long x, y;
+     casacore::Int sign, alignIn, alignOut, nthreads;
+     PlanKey(): x(0), y(0), sign(0), alignIn(-1), alignOut(-1), nthreads(0) {};
+     PlanKey(casacore::Long xx, casacore::Long yy, casacore::Int s, casacore::Int ain, casacore::Int aout, casacore::Int nth): x(xx), y(yy), sign(s), alignIn(ain), alignOut(aout), nthreads(nth) {};
+     casacore::Bool operator==(const PlanKey& o) const {return x==o.x && y==o.y && sign==o.sign && alignIn==o.alignIn && alignOut==o.alignOut && nthreads==o.nthreads;};
+   };
+   void clearPlans();
+   //Number of threads FFTW plans are made for
+   casacore::Int planThreads() const;
    //casacore::FFTW stuff
+   //The plans are kept and run on new data with fftw(f)_execute_dft*
+   //as long as the key they were made for still matches
    fftwf_plan planC2C_p;
    fftwf_plan planR2C_p;
    fftw_plan planC2CD_p;
+   PlanKey keyC2C_p, keyR2C_p, keyC2CD_p;
    casacore::Bool useFFTW_p;
    //casacore::FFTPack stuff
    std::vector<casacore::Float> wsave_p;
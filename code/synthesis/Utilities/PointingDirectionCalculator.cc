@@ -140,7 +140,8 @@ PointingDirectionCalculator::PointingDirectionCalculator(
         NULL), directionType_(MDirection::J2000), movingSource_(NULL), movingSourceConvert_(
         NULL), movingSourceCorrection_(NULL), antennaBoundary_(), numAntennaBoundary_(
                 0), pointingTimeUTC_(), lastTimeStamp_(-1.0), lastAntennaIndex_(
-                -1), pointingTableIndexCache_(0), shape_(
+                -1), pointingTableIndexCache_(0), pointingDirectionCache_(), pointingDirectionType_(
+        MDirection::J2000), pointingDirectionCacheUpToDate_(False), shape_(
                 PointingDirectionCalculator::COLUMN_MAJOR) {
     accessor_ = directionAccessor;
 
@@ -282,6 +283,9 @@ void PointingDirectionCalculator::setDirectionColumn(String const &columnName) {
         throw AipsError(ss.str());
     }
 
+    // cached directions refer to the previous column
+    pointingDirectionCacheUpToDate_ = False;
+
     configureMovingSourceCorrection();
 }
 
@@ -421,9 +425,18 @@ Vector<Double> PointingDirectionCalculator::doGetDirection(uInt irow) {
 //    pointingTableIndexCache_ = (uInt) max((Int) 0, (Int) (index - 1));
     debuglog << "Time " << setprecision(16) << currentTime << " idx=" << index
             << debugpost;
+    if (!pointingDirectionCacheUpToDate_) {
+        initPointingDirectionCache();
+    }
     MDirection direction;
     assert(accessor_ != NULL);
-    if (exactMatch) {
+    if (pointingDirectionCache_.ncolumn() > 0) {
+        debuglog << "interpolate cached directions" << debugpost;
+        Vector<Double> interpolated(2);
+        interpolateDirectionCache(currentTime, index, exactMatch, interpolated);
+        direction = MDirection(Quantum<Vector<Double> >(interpolated, "rad"),
+                pointingDirectionType_);
+    } else if (exactMatch) {
         debuglog << "exact match" << debugpost;
         direction = accessor_(*pointingColumns_, index);
     } else if (index <= 0) {
@@ -605,9 +618,66 @@ void PointingDirectionCalculator::initPointingTable(Int const antennaId) {
     // reset index cache for pointing table
     pointingTableIndexCache_ = 0;
 
+    // direction cache must be rebuilt for new antenna
+    pointingDirectionCacheUpToDate_ = False;
+
     debuglog << "done initPointingTable" << debugpost;
 }
 
+void PointingDirectionCalculator::initPointingDirectionCache() {
+    // Read all directions of current POINTING table once so that
+    // doGetDirection doesn't access the table for every MS row.
+    // If reference frames differ among rows, interpolation needs
+    // frame conversion between rows. In that case, cache is left
+    // empty and directions are taken from the table as before.
+    assert(accessor_ != NULL);
+    uInt const nrowPointing = pointingTimeUTC_.nelements();
+    pointingDirectionCache_.resize(2, nrowPointing);
+    pointingDirectionCacheUpToDate_ = True;
+    if (nrowPointing == 0) {
+        return;
+    }
+    String refString;
+    for (uInt i = 0; i < nrowPointing; ++i) {
+        MDirection direction = accessor_(*pointingColumns_, i);
+        if (i == 0) {
+            refString = direction.getRefString();
+            MDirection::getType(pointingDirectionType_, refString);
+        } else if (direction.getRefString() != refString) {
+            debuglog << "mixed reference frames in POINTING table. disable cache"
+                    << debugpost;
+            pointingDirectionCache_.resize();
+            return;
+        }
+        pointingDirectionCache_.column(i) = direction.getAngle("rad").getValue();
+    }
+    debuglog << "cached " << nrowPointing << " directions" << debugpost;
+}
+
+void PointingDirectionCalculator::interpolateDirectionCache(Double const time,
+        Int const index, Bool const exactMatch, Vector<Double> &direction) {
+    // index and exactMatch are the result of binarySearch on pointingTimeUTC_
+    uInt const nrowPointing = pointingTimeUTC_.nelements();
+    if (exactMatch) {
+        direction = pointingDirectionCache_.column(index);
+    } else if (index <= 0) {
+        direction = pointingDirectionCache_.column(0);
+    } else if (index > (Int) (nrowPointing - 1)) {
+        direction = pointingDirectionCache_.column(nrowPointing - 1);
+    } else {
+        Double t0 = pointingTimeUTC_[index - 1];
+        Double t1 = pointingTimeUTC_[index];
+        Double dt = t1 - t0;
+        Double a = (t1 - time) / dt;
+        Double b = (time - t0) / dt;
+        for (uInt k = 0; k < 2; ++k) {
+            Double y0 = pointingDirectionCache_(k, index - 1);
+            Double y1 = pointingDirectionCache_(k, index);
+            direction[k] = a * y0 + b * y1;
+        }
+    }
+}
+
 void PointingDirectionCalculator::resetAntennaPosition(Int const antennaId) {
     MSAntenna antennaTable = selectedMS_->antenna();
     uInt nrow = antennaTable.nrow();
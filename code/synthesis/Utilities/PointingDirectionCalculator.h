@@ -90,6 +90,10 @@ private:
     void inspectAntenna();
     void configureMovingSourceCorrection();
     casacore::Vector<casacore::Double> doGetDirection(casacore::uInt irow);
+    void initPointingDirectionCache();
+    void interpolateDirectionCache(casacore::Double const time,
+            casacore::Int const index, casacore::Bool const exactMatch,
+            casacore::Vector<casacore::Double> &direction);
 
     // table access stuff
     casacore::CountedPtr<casacore::MeasurementSet> originalMS_;
@@ -123,6 +127,11 @@ private:
     casacore::Double lastTimeStamp_;
     casacore::Int lastAntennaIndex_;
     casacore::uInt pointingTableIndexCache_;
+    // direction values (rad) of the POINTING table of current antenna,
+    // shape (2, nrowPointing). Empty if the table mixes reference frames.
+    casacore::Matrix<casacore::Double> pointingDirectionCache_;
+    casacore::MDirection::Types pointingDirectionType_;
+    casacore::Bool pointingDirectionCacheUpToDate_;
     PointingDirectionCalculator::MatrixShape shape_;
 
     // privatize  default constructor
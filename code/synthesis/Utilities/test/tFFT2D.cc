@@ -42,14 +42,140 @@
 #include <scimath/Mathematics/FFTPack.h>
 #include <synthesis/Utilities/FFT2D.h>
 #include <lattices/LatticeMath/LatticeFFT.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Utilities/Assert.h>
+#include <vector>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 using namespace casa;
+
+// A test plane of x by y pixels
+void fillPlane(Complex *data, Long x, Long y){
+  for (Long k=0; k < x*y; ++k)
+    data[k]=Complex(Float((k*7)%13)-6.0, Float((k*5)%11)-5.0);
+}
+
+// true if got agrees with ref to the precision of the transform
+template <class T> Bool agree(const T *got, const T *ref, Long n, Double tol){
+  Double scale=0.0;
+  for (Long k=0; k < n; ++k)
+    scale=max(scale, Double(abs(ref[k])));
+  for (Long k=0; k < n; ++k)
+    if(Double(abs(got[k]-ref[k])) > tol*(1.0+scale))
+      return false;
+  return true;
+}
+
+// Transforms data with ft, and with a new FFT2D which plans afresh, and
+// checks that they agree
+void checkC2C(FFT2D& ft, Complex *data, Long x, Long y, Bool toFreq){
+  fillPlane(data, x, y);
+  Vector<Complex> expected(IPosition(1, x*y));
+  Bool del;
+  Complex *ref=expected.getStorage(del);
+  fillPlane(ref, x, y);
+  FFT2D fresh(true);
+  fresh.doFFT(ref, x, y, toFreq);
+  ft.doFFT(data, x, y, toFreq);
+  AlwaysAssertExit(agree(data, ref, x*y, 1e-5));
+  expected.putStorage(ref, del);
+}
+
+void checkDC2C(FFT2D& ft, Long x, Long y, Bool toFreq){
+  Vector<DComplex> data(IPosition(1, x*y)), expected(IPosition(1, x*y));
+  for (Long k=0; k < x*y; ++k)
+    data[k]=expected[k]=DComplex(Double((k*7)%13)-6.0, Double((k*5)%11)-5.0);
+  Bool del, delRef;
+  DComplex *dat=data.getStorage(del);
+  DComplex *ref=expected.getStorage(delRef);
+  FFT2D fresh(true);
+  fresh.doFFT(ref, x, y, toFreq);
+  ft.doFFT(dat, x, y, toFreq);
+  AlwaysAssertExit(agree(dat, ref, x*y, 1e-12));
+  data.putStorage(dat, del);
+  expected.putStorage(ref, delRef);
+}
+
+void checkR2C(FFT2D& ft, Float *in, Long x, Long y){
+  for (Long k=0; k < x*y; ++k)
+    in[k]=Float((k*7)%13)-6.0;
+  Vector<Float> inExp(IPosition(1, x*y));
+  Vector<Complex> out(IPosition(1, (x/2+1)*y)), outExp(IPosition(1, (x/2+1)*y));
+  Bool delIn, delOut, delOutExp;
+  Float *inE=inExp.getStorage(delIn);
+  for (Long k=0; k < x*y; ++k)
+    inE[k]=in[k];
+  Complex *o=out.getStorage(delOut);
+  Complex *oE=outExp.getStorage(delOutExp);
+  FFT2D fresh(true);
+  fresh.doFFT(oE, inE, x, y);
+  ft.doFFT(o, in, x, y);
+  AlwaysAssertExit(agree(o, oE, (x/2+1)*y, 1e-5));
+  inExp.putStorage(inE, delIn);
+  out.putStorage(o, delOut);
+  outExp.putStorage(oE, delOutExp);
+}
+
+// The plans an FFT2D keeps must be remade when the size, the direction,
+// the alignment of the data or the number of threads change, and must not
+// be shared between copies
+void checkPlanReuse(){
+  std::vector<Complex> buf(2*32*16+1);
+  // the second buffer is off the first one's FFTW alignment
+  Complex *aligned=&buf[0];
+  Complex *shifted=&buf[32*16+1];
+  FFT2D ft(true);
+  // same key twice, then a new size, then back
+  checkC2C(ft, aligned, 16, 8, true);
+  checkC2C(ft, aligned, 16, 8, true);
+  checkC2C(ft, aligned, 32, 16, true);
+  checkC2C(ft, aligned, 16, 8, true);
+  // direction
+  checkC2C(ft, aligned, 16, 8, false);
+  checkC2C(ft, aligned, 16, 8, true);
+  // alignment
+  checkC2C(ft, shifted, 16, 8, true);
+  checkC2C(ft, aligned, 16, 8, true);
+  // double precision and real to complex
+  checkDC2C(ft, 16, 8, true);
+  checkDC2C(ft, 32, 16, false);
+  std::vector<Float> inbuf(32*16+1);
+  checkR2C(ft, &inbuf[0], 16, 8);
+  checkR2C(ft, &inbuf[1], 16, 8);
+  checkR2C(ft, &inbuf[0], 32, 16);
+#ifdef _OPENMP
+  // number of threads
+  Int nth=omp_get_max_threads();
+  omp_set_num_threads(1);
+  checkC2C(ft, aligned, 16, 8, true);
+  omp_set_num_threads(nth);
+  checkC2C(ft, aligned, 16, 8, true);
+#endif
+  // copies make their own plans, and outlive the original
+  {
+    FFT2D *orig=new FFT2D(true);
+    checkC2C(*orig, aligned, 16, 8, true);
+    FFT2D copy(*orig);
+    FFT2D assigned(false);
+    assigned=*orig;
+    checkC2C(*orig, aligned, 32, 16, false);
+    delete orig;
+    checkC2C(copy, aligned, 16, 8, true);
+    checkC2C(assigned, aligned, 16, 8, true);
+    checkC2C(copy, shifted, 32, 16, false);
+    assigned=copy;
+    checkC2C(assigned, aligned, 16, 8, false);
+    checkC2C(copy, aligned, 16, 8, true);
+  }
+  cout << "FFTW plan reuse OK" << endl;
+}
+
 int main(int argc, char **argv)
 {
  
   try{ 
+    checkPlanReuse();
     
 
  Matrix<Double> xform(2,2);
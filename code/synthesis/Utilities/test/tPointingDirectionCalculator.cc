@@ -0,0 +1,182 @@
+//# tPointingDirectionCalculator.cc:  this tests PointingDirectionCalculator
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU  General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <casa/aips.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/Matrix.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Utilities/Assert.h>
+#include <tables/Tables/SetupNewTab.h>
+#include <ms/MeasurementSets/MeasurementSet.h>
+#include <ms/MeasurementSets/MSColumns.h>
+#include <synthesis/Utilities/PointingDirectionCalculator.h>
+#include <casa/namespace.h>
+using namespace casa;
+
+namespace {
+// POINTING table layout: nant antennas, each with npoint samples at
+// time0 + k seconds
+const Int nant=2;
+const Int npoint=10;
+const Double time0=4.9e9;
+
+// A curved scan, so that anything but linear interpolation between
+// neighbouring samples shows up
+Vector<Double> scanDirection(Int ant, Int k){
+  Vector<Double> dir(2);
+  dir[0]=0.1*ant + 0.01*k + 0.001*k*k;
+  dir[1]=-0.5 + 0.0002*k*k*k;
+  return dir;
+}
+
+Vector<Double> targetDirection(Int ant, Int k){
+  Vector<Double> dir=scanDirection(ant, k);
+  dir[0]+=0.2;
+  dir[1]+=0.1;
+  return dir;
+}
+
+// Linear interpolation of the samples, clamped to the first and last one
+Vector<Double> expectedDirection(Vector<Double> (*sample)(Int, Int),
+                                 Int ant, Double time){
+  Double t=time-time0;
+  if(t <= 0.0)
+    return sample(ant, 0);
+  if(t >= npoint-1)
+    return sample(ant, npoint-1);
+  Int k=Int(t);
+  Double b=t-k;
+  Vector<Double> dir=sample(ant, k)*(1.0-b);
+  if(b > 0.0)
+    dir+=sample(ant, k+1)*b;
+  return dir;
+}
+
+// A POINTING direction cell, without polynomial terms
+Matrix<Double> directionCell(const Vector<Double> &dir){
+  Matrix<Double> cell(2, 1);
+  cell.column(0)=dir;
+  return cell;
+}
+
+// MS row times relative to time0: before the first sample, on a sample,
+// between samples, and after the last one
+const Double rowTimes[]={-0.5, 2.0, 3.25, 7.5, 9.5};
+const Int nrowTime=sizeof(rowTimes)/sizeof(rowTimes[0]);
+
+MeasurementSet makeMS(){
+  SetupNewTable newTab("tPointingDirectionCalculator_tmp.ms",
+                       MS::requiredTableDesc(), Table::Scratch);
+  MeasurementSet ms(newTab);
+  ms.createDefaultSubtables(Table::Scratch);
+
+  MSAntennaColumns antCols(ms.antenna());
+  for (Int ant=0; ant < nant; ++ant){
+    ms.antenna().addRow();
+    Vector<Double> pos(3);
+    pos[0]=2225142.18; pos[1]=-5440307.37+10.0*ant; pos[2]=-2481029.85;
+    antCols.position().put(ant, pos);
+  }
+
+  // the last antenna first and the samples in reverse, so that the
+  // calculator has to sort both tables
+  MSPointingColumns pointCols(ms.pointing());
+  uInt prow=0;
+  for (Int ant=nant-1; ant >= 0; --ant){
+    for (Int k=npoint-1; k >= 0; --k){
+      ms.pointing().addRow();
+      pointCols.antennaId().put(prow, ant);
+      pointCols.time().put(prow, time0+k);
+      pointCols.interval().put(prow, 1.0);
+      pointCols.numPoly().put(prow, 0);
+      pointCols.timeOrigin().put(prow, time0+k);
+      pointCols.direction().put(prow, directionCell(scanDirection(ant, k)));
+      pointCols.target().put(prow, directionCell(targetDirection(ant, k)));
+      pointCols.tracking().put(prow, True);
+      ++prow;
+    }
+  }
+
+  MSMainColumns mainCols(ms);
+  uInt row=0;
+  for (Int ant=nant-1; ant >= 0; --ant){
+    for (Int i=nrowTime-1; i >= 0; --i){
+      ms.addRow();
+      mainCols.antenna1().put(row, ant);
+      mainCols.antenna2().put(row, ant);
+      mainCols.time().put(row, time0+rowTimes[i]);
+      mainCols.interval().put(row, 1.0);
+      ++row;
+    }
+  }
+  return ms;
+}
+
+// Checks the directions of every row, both from the whole list and one
+// row at a time, against the linear interpolation of the samples
+void checkDirections(PointingDirectionCalculator &calc,
+                     Vector<Double> (*sample)(Int, Int),
+                     const MeasurementSet &ms){
+  ROMSMainColumns mainCols(ms);
+  Matrix<Double> dirs=calc.getDirection();
+  Vector<uInt> rowIds=calc.getRowIdForOriginalMS();
+  AlwaysAssertExit(dirs.shape()==IPosition(2, nant*nrowTime, 2));
+  for (uInt i=0; i < rowIds.nelements(); ++i){
+    Int ant=mainCols.antenna1()(rowIds[i]);
+    Vector<Double> expected=expectedDirection(sample, ant,
+                                              mainCols.time()(rowIds[i]));
+    AlwaysAssertExit(allNearAbs(dirs.row(i), expected, 1e-12));
+    AlwaysAssertExit(allNearAbs(calc.getDirection(i), expected, 1e-12));
+  }
+}
+}
+
+int main()
+{
+  try{
+    MeasurementSet ms=makeMS();
+    PointingDirectionCalculator calc(ms);
+    checkDirections(calc, scanDirection, ms);
+    cout << "DIRECTION interpolated linearly" << endl;
+
+    // the cached directions must follow the column
+    calc.setDirectionColumn("TARGET");
+    checkDirections(calc, targetDirection, ms);
+    calc.setDirectionColumn("DIRECTION");
+    checkDirections(calc, scanDirection, ms);
+    cout << "Cache follows the direction column" << endl;
+  }
+  catch (AipsError& x) {
+    cout << "Exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
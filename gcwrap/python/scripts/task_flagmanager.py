@@ -38,6 +38,7 @@ def flagmanager(
                 
                 tmpdir = newdir+'.old.'+str(tt)
                 # Rename existing versionname to old name
+                retarget_flag_deltas(vis, versionname, tmpname)
                 os.rename(newdir, tmpdir)
     
                 # Edit entry in .flagversions/FLAG_VERSION_LIST
@@ -91,6 +92,7 @@ def flagmanager(
             casalog.post('Rename flagversions "%s" to "%s"' % (oldname,
                          versionname))
 
+            retarget_flag_deltas(vis, oldname, versionname)
             os.rename(olddir, newdir)
 
             # Edit entry in .flagversions/FLAG_VERSION_LIST
@@ -118,3 +120,18 @@ def flagmanager(
         raise Exception, instance
 
 
+def retarget_flag_deltas(vis, oldname, newname):
+    # Versions saved as deltas (FlagVersion.delta in aipsrc) name the
+    # version they are stored against in the FLAG_VERSION_BASE keyword
+    verdir = vis + '.flagversions/'
+    tblocal = tbtool()
+    for entry in os.listdir(verdir):
+        if not entry.startswith('flags.'):
+            continue
+        tblocal.open(verdir + entry, nomodify=False)
+        try:
+            if 'FLAG_VERSION_BASE' in tblocal.keywordnames() and \
+                    tblocal.getkeyword('FLAG_VERSION_BASE') == oldname:
+                tblocal.putkeyword('FLAG_VERSION_BASE', newname)
+        finally:
+            tblocal.close()